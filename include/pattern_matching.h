@@ -6,6 +6,11 @@
 #ifndef PATTERN_MATCHING_H
 #define PATTERN_MATCHING_H
 
+// struct timespec / clock_gettime need POSIX visibility under -std=c99
+#if !defined(_POSIX_C_SOURCE) && !defined(_GNU_SOURCE)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -15,10 +20,28 @@
 typedef struct {
     int *positions;          // Array of match positions
     int count;               // Number of matches found
-    double time_taken;       // Time in milliseconds
+    double time_taken;       // CPU time in milliseconds (clock())
     size_t memory_used;      // Memory used in bytes
+    long long wall_time_ns;  // Monotonic wall-clock time in nanoseconds
+    long long hw_cycles;         // Hardware counters (perf events);
+    long long hw_cache_misses;   // -1 when unavailable (permissions,
+    long long hw_branch_misses;  // kernel, or non-Linux platform)
 } MatchResult;
 
+// Performance instrumentation - wraps a search with CPU + monotonic
+// wall clocks and, where the kernel allows, perf-event hardware
+// counters. perf_timer_stop() fills the timing and counter fields of
+// the result; init_match_result() zeroes a result (counters to -1).
+typedef struct {
+    clock_t cpu_start;
+    struct timespec wall_start;
+    int fds[3];              // perf-event fds: cycles, cache-misses, branch-misses
+} PerfTimer;
+
+void init_match_result(MatchResult *result);
+void perf_timer_start(PerfTimer *timer);
+void perf_timer_stop(PerfTimer *timer, MatchResult *result);
+
 // Structure for approximate matches
 typedef struct {
     int position;
@@ -44,6 +67,29 @@ MatchResult naive_search(const char *text, const char *pattern);
 void compute_bad_character(const char *pattern, int m, int bad_char[]);
 void compute_good_suffix(const char *pattern, int m, int *good_suffix);
 MatchResult boyer_moore_search(const char *text, const char *pattern);
+MatchResult horspool_dna_search(const char *text, const char *pattern);  // q-gram Horspool, auto-selected for ACGT patterns
+
+// Large-buffer allocation - genome-scale buffers (loaded sequences,
+// arena blocks, index arrays) get huge-page-backed mmap memory past a
+// 2 MB threshold; smaller requests fall through to malloc. Free with
+// large_free() regardless of which path served the allocation.
+void* large_alloc(size_t size);
+void* large_realloc(void *ptr, size_t new_size);
+void large_free(void *ptr);
+int large_alloc_uses_huge_pages(void *ptr);
+// Parallel page-zeroing for first-touch NUMA placement (<=0 threads =
+// one per core, matching parallel_search)
+void large_first_touch(void *ptr, size_t size, int num_threads);
+
+// Arena allocator - bump-pointer allocation, O(1) wholesale teardown.
+// Backs node-heavy structures (suffix tree) so construction does not pay
+// one malloc per node and destruction does not walk millions of nodes.
+typedef struct Arena Arena;
+
+Arena* arena_create(size_t block_size);
+void* arena_alloc(Arena *arena, size_t size);
+size_t arena_total_allocated(const Arena *arena);
+void arena_destroy(Arena *arena);
 
 // Suffix Tree Algorithm
 typedef struct SuffixTreeNode SuffixTreeNode;
@@ -52,22 +98,129 @@ typedef struct {
     char *text;
     SuffixTreeNode *root;
     int size;
+    Arena *arena;        // All nodes live here; freed wholesale in teardown
+    int *suffix_positions;  // All leaf suffix indices in Euler-tour order;
+    int num_suffixes;       // each node owns one contiguous slice of it
 } SuffixTree;
 
 SuffixTree* create_suffix_tree(const char *text);
 MatchResult suffix_tree_search(SuffixTree *tree, const char *pattern);
+MatchResult suffix_tree_count(SuffixTree *tree, const char *pattern);  // O(m), no positions
+// Probe-panel batch: one result per pattern (caller's order); shared
+// prefixes across sorted probes are walked once instead of per query
+MatchResult* suffix_tree_search_many(SuffixTree *tree, const char **patterns,
+                                     int pattern_count);
 void free_suffix_tree(SuffixTree *tree);
 
+// Algorithm identifiers for drivers that dispatch to the exact matchers
+typedef enum {
+    SEARCH_ALGO_NAIVE,
+    SEARCH_ALGO_KMP,
+    SEARCH_ALGO_BOYER_MOORE,
+    SEARCH_ALGO_RABIN_KARP,
+    SEARCH_ALGO_Z,
+    SEARCH_ALGO_SHIFT_OR
+} SearchAlgorithm;
+
+// Parallel Chunked Search Driver
+// Splits the text into per-thread chunks with (m-1)-byte overlap and merges
+// position lists in text order. nthreads <= 0 uses all online CPUs.
+MatchResult parallel_search(SearchAlgorithm algo, const char *text, size_t text_len,
+                            const char *pattern, int nthreads);
+
+// Adaptive auto-selection - dispatches each query to the cheapest exact
+// matcher for its pattern length using an on-box calibration profile
+// (data/calibration.profile, written by calibrate_auto_search - see
+// `benchmark --calibrate`); falls back to rule-based routing for
+// non-DNA alphabets, tiny texts, or when no profile exists.
+SearchAlgorithm auto_select_algorithm(const char *text, size_t text_len, const char *pattern);
+MatchResult auto_search(const char *text, size_t text_len, const char *pattern);
+int calibrate_auto_search(const char *profile_path);  // NULL = default path
+int auto_profile_available(void);
+const char* search_algorithm_name(SearchAlgorithm algo);
+
+// Compiled-Pattern API - preprocess once, search many texts
+// compile_pattern() builds the algorithm's tables into a reusable handle;
+// search_compiled() takes an explicit length so no strlen pass is needed.
+typedef struct CompiledPattern CompiledPattern;
+
+CompiledPattern* compile_pattern(const char *pattern, SearchAlgorithm algo);
+MatchResult search_compiled(const CompiledPattern *handle, const char *text, size_t text_len);
+void free_compiled_pattern(CompiledPattern *handle);
+
+// Streaming search - process FASTA inputs far larger than RAM in fixed
+// windows with internal carry-over; match positions are global sequence
+// coordinates. Callbacks may return < 0 to stop early, or be NULL to count.
+typedef int (*CompiledMatchFn)(long long position, void *user);
+typedef int (*MultiMatchFn)(long long position, int pattern_id, void *user);
+
+long long stream_search_file(const CompiledPattern *handle, const char *filename,
+                             size_t buffer_size, CompiledMatchFn on_match, void *user);
+
+// Pipelined variant: a reader thread parses chunks into a ring of
+// buffers while the calling thread searches them, overlapping disk
+// time with compute. Same semantics and coordinates as the serial path.
+long long stream_search_file_pipelined(const CompiledPattern *handle, const char *filename,
+                                       size_t buffer_size, CompiledMatchFn on_match,
+                                       void *user);
+
+// Callback delivery for in-memory searches - matches go straight to the
+// callback with no position array built; returns the match count or -1
+long long search_compiled_cb(const CompiledPattern *handle, const char *text,
+                             size_t text_len, CompiledMatchFn on_match, void *user);
+long long search_cb(SearchAlgorithm algo, const char *text, size_t text_len,
+                    const char *pattern, CompiledMatchFn on_match, void *user);
+long long aho_corasick_stream_file(const char **patterns, int pattern_count,
+                                   const char *filename, size_t buffer_size,
+                                   MultiMatchFn on_match, void *user);
+
+// Reduced query modes for abundance screening and previews:
+// count_only_search() stores no positions at all (positions stays NULL,
+// count holds the total); sampled_search() keeps only every Nth match
+// and count reports how many were kept
+MatchResult count_only_search(SearchAlgorithm algo, const char *text, size_t text_len,
+                              const char *pattern);
+MatchResult sampled_search(SearchAlgorithm algo, const char *text, size_t text_len,
+                           const char *pattern, int every_nth);
+
+// FM-Index (BWT + backward search) - low-memory index for fixed-reference workloads
+typedef struct FMIndex FMIndex;
+
+FMIndex* create_fm_index(const char *text);
+MatchResult fm_index_search(FMIndex *index, const char *pattern);
+MatchResult fm_index_count(FMIndex *index, const char *pattern);  // O(m), no locate
+void free_fm_index(FMIndex *index);
+
+// Persistent index format: flat relocatable file, loaded with one mmap
+int save_fm_index(const FMIndex *index, const char *filename);
+FMIndex* load_fm_index(const char *filename);
+
+// k-mer seed index - O(n) build, then seed-and-extend queries that
+// verify only candidate loci of the pattern's rarest k-mer. The index
+// keeps a pointer to the text (no copy): text must outlive the index.
+typedef struct KmerIndex KmerIndex;
+
+KmerIndex* create_kmer_index(const char *text, int k);
+MatchResult seed_and_extend_search(const KmerIndex *index, const char *pattern);
+void free_kmer_index(KmerIndex *index);
+
 /* Visual helpers */
 void print_sequence_with_highlights(const char *sequence, const int *positions, int count, int pattern_len, int context);
 
 // Shift-Or (Bitap) Algorithm
 MatchResult shift_or_search(const char *text, const char *pattern);
 
+// SIMD Rare-Byte Prefilter (AVX2/SSE2 with scalar fallback at runtime)
+MatchResult simd_search(const char *text, const char *pattern);
+
 // Levenshtein Distance Search
 int levenshtein_distance(const char *s1, int len1, const char *s2, int len2);
 ApproximateMatchResult levenshtein_search(const char *text, const char *pattern, int max_distance);
 
+// Myers Bit-Parallel Approximate Search - O(n * ceil(m/64)) edit-distance
+// scan over the whole text; reports one match per qualifying end position
+ApproximateMatchResult myers_search(const char *text, const char *pattern, int max_distance);
+
 // DNA Sequence Handler
 typedef struct {
     char *sequence;
@@ -75,17 +228,120 @@ typedef struct {
     size_t length;
 } DNASequence;
 
+// Sanitization primitive shared by all loaders: upcases, keeps only
+// ACGTN, compacts everything else out via one 256-entry table (with a
+// SIMD fast path for already-clean blocks). dst may alias src.
+size_t sanitize_bases(const char *src, size_t len, char *dst);
+
+// Streaming FASTA reader - sanitized sequence data in caller-sized buffers
+typedef struct {
+    FILE *file;
+    int in_header;   // Mid-header-line state carried across reads
+} FastaStream;
+
+FastaStream* fasta_stream_open(const char *filename);
+long fasta_stream_read(FastaStream *stream, char *buffer, size_t capacity);
+void fasta_stream_close(FastaStream *stream);
+
+// Multi-record FASTA - one DNASequence per '>' record, so matches never
+// cross record boundaries the way the concatenating loader allows
+typedef struct {
+    DNASequence **records;
+    int count;
+} FastaCollection;
+
 DNASequence* load_fasta_file(const char *filename);
+DNASequence* load_fasta_file_mmap(const char *filename);
+FastaCollection* load_fasta_file_multi(const char *filename);
+void free_fasta_collection(FastaCollection *collection);
 void free_dna_sequence(DNASequence *seq);
+
+// Per-record parallel search over a collection: records fan out across a
+// thread pool and matches come back as (record, offset) pairs
+typedef struct {
+    int record_id;
+    int position;            // Offset within the record's sequence
+} RecordMatch;
+
+typedef struct {
+    RecordMatch *matches;
+    int count;
+    double time_taken;
+    size_t memory_used;
+} MultiRecordResult;
+
+MultiRecordResult multi_record_search(SearchAlgorithm algo, const FastaCollection *collection,
+                                      const char *pattern, int nthreads);
+void free_multi_record_result(MultiRecordResult *result);
+void print_multi_record_result(const char *algo_name, const MultiRecordResult *result,
+                               const FastaCollection *collection);
 char* generate_random_dna(int length);
 
-// Rabin-Karp Algorithm
+// 2-bit packed DNA (A=0 C=1 G=2 T=3, 32 bases per 64-bit word)
+// Quarter the footprint of one-byte-per-base and 32 bases per compare
+typedef struct {
+    unsigned long long *words;
+    size_t length;       // Number of bases
+    size_t num_words;
+} PackedDNA;
+
+PackedDNA* pack_dna_sequence(const char *sequence, size_t length);
+PackedDNA* load_fasta_file_packed(const char *filename);
+void free_packed_dna(PackedDNA *packed);
+
+// Packed-aware search kernels (word-at-a-time comparison)
+MatchResult packed_naive_search(const PackedDNA *text, const char *pattern);
+MatchResult packed_kmp_search(const PackedDNA *text, const char *pattern);
+
+// Dual-strand search - forward and reverse-complement patterns in a
+// single pass where the algorithm allows (paired automata for KMP,
+// paired state words for Shift-Or, two fingerprints for Rabin-Karp);
+// each match carries its strand: '+' forward, '-' reverse complement
+typedef struct {
+    int *positions;
+    char *strands;           // One of '+' / '-' per match
+    int count;
+    double time_taken;
+    size_t memory_used;
+} StrandMatchResult;
+
+char* reverse_complement(const char *pattern);
+StrandMatchResult dual_strand_search(SearchAlgorithm algo, const char *text,
+                                     const char *pattern);
+void free_strand_match_result(StrandMatchResult *result);
+void print_strand_match_result(const char *algo_name, const StrandMatchResult *result);
+
+// Rabin-Karp Algorithm - 64-bit rolling hash modulo the Mersenne prime
+// 2^61 - 1, so character verification fires only on true fingerprint hits.
+// The batch variant rolls RK_LANES independent window stripes per loop
+// iteration to hide multiply latency.
+#define RK_MERSENNE_P ((1ULL << 61) - 1)
+
+unsigned long long rk_mulmod(unsigned long long a, unsigned long long b);
+unsigned long long rk_pow_base(int exponent);
 MatchResult rabin_karp_search(const char *text, const char *pattern);
+MatchResult rabin_karp_batch_search(const char *text, const char *pattern);
 
 // Z-Algorithm
 MatchResult z_algorithm_search(const char *text, const char *pattern);
 void compute_lcp_using_z(const char *text, int n, int *lcp);
 
+// Incremental Z matcher for growing sequences: the handle carries the
+// last m-1 bases across appends, so each new chunk is scanned once and
+// data already seen is never reprocessed
+typedef struct {
+    char *pattern;
+    int m;
+    char *carry;              // Tail of everything seen so far (< m bases)
+    int carry_len;
+    long long consumed;       // Total bases appended
+    long long total_matches;  // Running count across all appends
+} IncrementalZ;
+
+IncrementalZ* create_incremental_z(const char *pattern);
+MatchResult incremental_z_append(IncrementalZ *iz, const char *bases, size_t len);
+void free_incremental_z(IncrementalZ *iz);
+
 // Aho-Corasick Algorithm (Multiple Pattern Matching)
 typedef struct {
     int position;
@@ -1,213 +1,343 @@
-/*
- * Aho-Corasick Algorithm Implementation
- * Multiple pattern matching using trie and failure links
- * Time Complexity: O(n + m + z) where z is number of matches
- * Space Complexity: O(m * σ) where σ is alphabet size
- * Excellent for finding multiple DNA motifs simultaneously
- */
-
-#include "pattern_matching.h"
-
-#define ALPHABET_SIZE 256
-#define MAX_PATTERNS 10
-
-typedef struct ACNode {
-    struct ACNode *children[ALPHABET_SIZE];
-    struct ACNode *failure;
-    int *output;
-    int output_count;
-} ACNode;
-
-typedef struct {
-    ACNode *root;
-    char **patterns;
-    int pattern_count;
-} ACTrie;
-
-static ACNode* create_ac_node() {
-    ACNode *node = (ACNode *)calloc(1, sizeof(ACNode));
-    if (!node) return NULL;
-    
-    for (int i = 0; i < ALPHABET_SIZE; i++) {
-        node->children[i] = NULL;
-    }
-    node->failure = NULL;
-    node->output = NULL;
-    node->output_count = 0;
-    return node;
-}
-
-static void add_pattern(ACTrie *trie, const char *pattern, int pattern_id) {
-    ACNode *current = trie->root;
-    int len = strlen(pattern);
-    
-    for (int i = 0; i < len; i++) {
-        unsigned char c = (unsigned char)pattern[i];
-        if (!current->children[c]) {
-            current->children[c] = create_ac_node();
-        }
-        current = current->children[c];
-    }
-    
-    // Mark end of pattern
-    int *new_output = (int *)realloc(current->output, (current->output_count + 1) * sizeof(int));
-    if (new_output) {
-        current->output = new_output;
-        current->output[current->output_count] = pattern_id;
-        current->output_count++;
-    }
-}
-
-static void build_failure_links(ACTrie *trie) {
-    // BFS queue implemented with a dynamically resizing array to avoid fixed-size overflow
-    size_t qcap = 1024;
-    ACNode **queue = (ACNode **)malloc(qcap * sizeof(ACNode *));
-    size_t front = 0, rear = 0;
-
-    // Initialize root's children
-    for (int i = 0; i < ALPHABET_SIZE; i++) {
-        if (trie->root->children[i]) {
-            trie->root->children[i]->failure = trie->root;
-            if (rear >= qcap) {
-                qcap *= 2;
-                ACNode **tmp = (ACNode **)realloc(queue, qcap * sizeof(ACNode *));
-                if (tmp) queue = tmp;
-            }
-            queue[rear++] = trie->root->children[i];
-        }
-    }
-
-    // Build failure links using BFS
-    // Failure link points to the longest proper suffix of the current string 
-    // that is also a prefix of some pattern in the trie.
-    while (front < rear) {
-        ACNode *current = queue[front++];
-
-        for (int i = 0; i < ALPHABET_SIZE; i++) {
-            if (current->children[i]) {
-                ACNode *child = current->children[i];
-                if (rear >= qcap) {
-                    qcap *= 2;
-                    ACNode **tmp = (ACNode **)realloc(queue, qcap * sizeof(ACNode *));
-                    if (tmp) queue = tmp;
-                }
-                queue[rear++] = child;
-
-                ACNode *failure = current->failure;
-                // Traverse failure links until a node with transition 'i' is found
-                while (failure && !failure->children[i]) {
-                    failure = failure->failure;
-                }
-
-                child->failure = failure ? failure->children[i] : trie->root;
-                
-                // Output links are not explicitly merged here; 
-                // instead, we traverse the failure chain during search to collect all matches.
-            }
-        }
-    }
-    
-    free(queue);
-}
-
-static void free_ac_node(ACNode *node) {
-    if (!node) return;
-    for (int i = 0; i < ALPHABET_SIZE; i++) {
-        if (node->children[i]) {
-            free_ac_node(node->children[i]);
-        }
-    }
-    if (node->output) {
-        free(node->output);
-    }
-    free(node);
-}
-
-MultiPatternResult aho_corasick_search(const char *text, const char **patterns, int pattern_count) {
-    MultiPatternResult result;
-    result.matches = NULL;
-    result.match_count = 0;
-    result.time_taken = 0.0;
-    result.memory_used = 0;
-    
-    if (!text || !patterns || pattern_count == 0) {
-        return result;
-    }
-    
-    clock_t start = clock();
-    
-    // Build AC trie
-    ACTrie trie;
-    trie.root = create_ac_node();
-    trie.patterns = (char **)patterns;
-    trie.pattern_count = pattern_count;
-    
-    // Add all patterns to trie
-    for (int i = 0; i < pattern_count; i++) {
-        add_pattern(&trie, patterns[i], i);
-    }
-    
-    // Build failure links
-    build_failure_links(&trie);
-    
-    // Search in text
-    int capacity = 100;
-    result.matches = (PatternMatch *)malloc(capacity * sizeof(PatternMatch));
-    int count = 0;
-    
-    ACNode *current = trie.root;
-    int text_len = strlen(text);
-    
-    for (int i = 0; i < text_len; i++) {
-        unsigned char c = (unsigned char)text[i];
-        
-        // Follow failure links if current char doesn't match
-        // This simulates the transition in the Aho-Corasick automaton
-        while (current != trie.root && !current->children[c]) {
-            current = current->failure;
-        }
-        
-        if (current->children[c]) {
-            current = current->children[c];
-        } else {
-            current = trie.root;
-        }
-        
-        // Traverse failure chain to find all patterns ending at this position
-        // This handles cases where one pattern is a suffix of another (e.g., "he" inside "she")
-        for (ACNode *temp = current; temp != NULL; temp = temp->failure) {
-            if (temp->output) {
-                for (int j = 0; j < temp->output_count; j++) {
-                    int pattern_id = temp->output[j];
-                    int pattern_len = strlen(patterns[pattern_id]);
-
-                    if (count >= capacity) {
-                        capacity *= 2;
-                        PatternMatch *new_matches = (PatternMatch *)realloc(result.matches, 
-                                                                     capacity * sizeof(PatternMatch));
-                        if (new_matches) {
-                            result.matches = new_matches;
-                        }
-                    }
-
-                    result.matches[count].position = i - pattern_len + 1;
-                    result.matches[count].pattern_id = pattern_id;
-                    result.matches[count].pattern_length = pattern_len;
-                    count++;
-                }
-            }
-            if (temp == trie.root) break; // Stop at root to avoid infinite loops if root failure is set incorrectly
-        }
-    }
-    
-    clock_t end = clock();
-    
-    result.match_count = count;
-    result.time_taken = ((double)(end - start)) / CLOCKS_PER_SEC * 1000.0;
-    result.memory_used = capacity * sizeof(PatternMatch);
-    
-    // Cleanup Trie to prevent memory leaks
-    free_ac_node(trie.root);
-    
-    return result;
-}
+/*
+ * Aho-Corasick Algorithm Implementation
+ * Multiple pattern matching over the DNA alphabet (A, C, G, T, N)
+ * Time Complexity: O(n + m + z) where z is number of matches
+ * Space Complexity: O(total pattern length * 5)
+ *
+ * States live in one contiguous pool indexed by int (realloc-safe, no
+ * pointer chasing) with 5-entry transition rows instead of 256-pointer
+ * arrays, so a 50k-pattern motif library fits in a few MB of cache-
+ * friendly tables. Goto transitions are completed during the BFS, so
+ * the scan is a single table lookup per character with no failure-link
+ * walking; dictionary suffix links make output collection O(z).
+ */
+
+#include "pattern_matching.h"
+
+#define AC_ALPHABET 5  // A, C, G, T, N
+
+typedef struct {
+    int next[AC_ALPHABET];  // Complete goto function after build (no misses)
+    int fail;               // Failure link (build-time only after goto completion)
+    int dict_link;          // Nearest dictionary state on the failure chain (-1 none)
+    int *output;            // Pattern ids ending at this state
+    int output_count;
+} ACState;
+
+typedef struct {
+    ACState *states;
+    int state_count;
+    int state_capacity;
+} ACAutomaton;
+
+// Byte -> DNA symbol code, -1 for characters outside the alphabet
+static int ac_code(unsigned char c) {
+    switch (c) {
+        case 'A': case 'a': return 0;
+        case 'C': case 'c': return 1;
+        case 'G': case 'g': return 2;
+        case 'T': case 't': return 3;
+        case 'N': case 'n': return 4;
+        default: return -1;
+    }
+}
+
+// Appends a fresh state to the pool. Returns its index, or -1 on failure
+static int ac_new_state(ACAutomaton *ac) {
+    if (ac->state_count >= ac->state_capacity) {
+        ac->state_capacity *= 2;
+        ACState *temp = (ACState *)realloc(ac->states, ac->state_capacity * sizeof(ACState));
+        if (!temp) return -1;
+        ac->states = temp;
+    }
+
+    ACState *state = &ac->states[ac->state_count];
+    for (int i = 0; i < AC_ALPHABET; i++) state->next[i] = -1;
+    state->fail = 0;
+    state->dict_link = -1;
+    state->output = NULL;
+    state->output_count = 0;
+
+    return ac->state_count++;
+}
+
+// Inserts one pattern into the trie. Returns: 0 on success, -1 on failure
+static int ac_add_pattern(ACAutomaton *ac, const char *pattern, int pattern_id) {
+    int state = 0;
+    int len = strlen(pattern);
+
+    for (int i = 0; i < len; i++) {
+        int code = ac_code((unsigned char)pattern[i]);
+        if (code < 0) {
+            fprintf(stderr, "Aho-Corasick: skipping pattern %d (non-DNA character '%c')\n",
+                    pattern_id, pattern[i]);
+            return 0;
+        }
+        if (ac->states[state].next[code] < 0) {
+            int child = ac_new_state(ac);
+            if (child < 0) return -1;
+            ac->states[state].next[code] = child;
+        }
+        state = ac->states[state].next[code];
+    }
+
+    int *new_output = (int *)realloc(ac->states[state].output,
+                                     (ac->states[state].output_count + 1) * sizeof(int));
+    if (!new_output) return -1;
+    ac->states[state].output = new_output;
+    ac->states[state].output[ac->states[state].output_count++] = pattern_id;
+    return 0;
+}
+
+// BFS pass: completes the goto function (missing transitions route via the
+// failure target) and computes failure and dictionary suffix links.
+// Returns: 0 on success, -1 on allocation failure
+static int ac_build_links(ACAutomaton *ac) {
+    int *queue = (int *)malloc(ac->state_count * sizeof(int));
+    if (!queue) return -1;
+    int front = 0, rear = 0;
+
+    for (int c = 0; c < AC_ALPHABET; c++) {
+        int child = ac->states[0].next[c];
+        if (child < 0) {
+            ac->states[0].next[c] = 0;
+        } else {
+            ac->states[child].fail = 0;
+            queue[rear++] = child;
+        }
+    }
+
+    while (front < rear) {
+        int state = queue[front++];
+        int fail = ac->states[state].fail;
+
+        // Dictionary link: nearest output-bearing state up the failure chain
+        ac->states[state].dict_link = (ac->states[fail].output_count > 0)
+                                      ? fail : ac->states[fail].dict_link;
+
+        for (int c = 0; c < AC_ALPHABET; c++) {
+            int child = ac->states[state].next[c];
+            if (child < 0) {
+                // Complete the transition: borrow the failure target's
+                ac->states[state].next[c] = ac->states[fail].next[c];
+            } else {
+                ac->states[child].fail = ac->states[fail].next[c];
+                queue[rear++] = child;
+            }
+        }
+    }
+
+    free(queue);
+    return 0;
+}
+
+static void ac_free(ACAutomaton *ac) {
+    if (!ac->states) return;
+    for (int i = 0; i < ac->state_count; i++) {
+        free(ac->states[i].output);
+    }
+    free(ac->states);
+    ac->states = NULL;
+}
+
+// Builds the full automaton (trie + completed goto + links) for a pattern
+// set. Returns: 0 on success, -1 on allocation failure
+static int ac_build(ACAutomaton *ac, const char **patterns, int pattern_count) {
+    ac->state_count = 0;
+    ac->state_capacity = 1024;
+    ac->states = (ACState *)malloc(ac->state_capacity * sizeof(ACState));
+    if (!ac->states) return -1;
+
+    if (ac_new_state(ac) < 0) {  // Root is state 0
+        ac_free(ac);
+        return -1;
+    }
+
+    for (int i = 0; i < pattern_count; i++) {
+        if (ac_add_pattern(ac, patterns[i], i) < 0) {
+            ac_free(ac);
+            return -1;
+        }
+    }
+
+    if (ac_build_links(ac) < 0) {
+        ac_free(ac);
+        return -1;
+    }
+    return 0;
+}
+
+MultiPatternResult aho_corasick_search(const char *text, const char **patterns, int pattern_count) {
+    MultiPatternResult result;
+    result.matches = NULL;
+    result.match_count = 0;
+    result.time_taken = 0.0;
+    result.memory_used = 0;
+
+    if (!text || !patterns || pattern_count == 0) {
+        return result;
+    }
+
+    clock_t start = clock();
+
+    // Pattern lengths, reused for match reporting
+    int *pattern_lens = (int *)malloc(pattern_count * sizeof(int));
+    if (!pattern_lens) return result;
+    for (int i = 0; i < pattern_count; i++) {
+        pattern_lens[i] = strlen(patterns[i]);
+    }
+
+    ACAutomaton ac;
+    if (ac_build(&ac, patterns, pattern_count) < 0) {
+        free(pattern_lens);
+        return result;
+    }
+
+    int capacity = 100;
+    result.matches = (PatternMatch *)malloc(capacity * sizeof(PatternMatch));
+    if (!result.matches) {
+        ac_free(&ac);
+        free(pattern_lens);
+        return result;
+    }
+    int count = 0;
+
+    int state = 0;
+    int text_len = strlen(text);
+
+    for (int i = 0; i < text_len; i++) {
+        int code = ac_code((unsigned char)text[i]);
+        if (code < 0) {
+            // Character outside the alphabet breaks every match in progress
+            state = 0;
+            continue;
+        }
+
+        // One cache-friendly table lookup per character
+        state = ac.states[state].next[code];
+
+        // Collect outputs at this state and along its dictionary chain
+        for (int s = (ac.states[state].output_count > 0) ? state : ac.states[state].dict_link;
+             s >= 0; s = ac.states[s].dict_link) {
+            for (int j = 0; j < ac.states[s].output_count; j++) {
+                int pattern_id = ac.states[s].output[j];
+
+                if (count >= capacity) {
+                    capacity *= 2;
+                    PatternMatch *new_matches = (PatternMatch *)realloc(result.matches,
+                                                                 capacity * sizeof(PatternMatch));
+                    if (!new_matches) {
+                        ac_free(&ac);
+                        free(pattern_lens);
+                        free(result.matches);
+                        result.matches = NULL;
+                        return result;
+                    }
+                    result.matches = new_matches;
+                }
+
+                result.matches[count].position = i - pattern_lens[pattern_id] + 1;
+                result.matches[count].pattern_id = pattern_id;
+                result.matches[count].pattern_length = pattern_lens[pattern_id];
+                count++;
+            }
+        }
+    }
+
+    clock_t end = clock();
+
+    result.match_count = count;
+    result.time_taken = ((double)(end - start)) / CLOCKS_PER_SEC * 1000.0;
+    result.memory_used = (size_t)ac.state_count * sizeof(ACState) +
+                         capacity * sizeof(PatternMatch);
+
+    ac_free(&ac);
+    free(pattern_lens);
+
+    return result;
+}
+
+/**
+ * Streams a FASTA file through the automaton in fixed-size buffers.
+ * The automaton state is the only thing carried across buffer
+ * boundaries - no overlap bytes are needed, because a match ending at
+ * global position i is recognized the moment character i is consumed
+ * regardless of which buffer it arrived in. Inputs far larger than RAM
+ * are processed at disk speed. buffer_size 0 uses a 4 MB default.
+ * on_match may be NULL to count only; returning < 0 stops the stream.
+ * Returns: number of matches, or -1 on error
+ */
+long long aho_corasick_stream_file(const char **patterns, int pattern_count,
+                                   const char *filename, size_t buffer_size,
+                                   MultiMatchFn on_match, void *user) {
+    if (!patterns || pattern_count == 0 || !filename) return -1;
+
+    if (buffer_size == 0) buffer_size = 4 * 1024 * 1024;
+
+    int *pattern_lens = (int *)malloc(pattern_count * sizeof(int));
+    if (!pattern_lens) return -1;
+    for (int i = 0; i < pattern_count; i++) {
+        pattern_lens[i] = strlen(patterns[i]);
+    }
+
+    ACAutomaton ac;
+    if (ac_build(&ac, patterns, pattern_count) < 0) {
+        free(pattern_lens);
+        return -1;
+    }
+
+    char *buffer = (char *)malloc(buffer_size);
+    FastaStream *stream = fasta_stream_open(filename);
+    if (!buffer || !stream) {
+        free(buffer);
+        if (stream) fasta_stream_close(stream);
+        ac_free(&ac);
+        free(pattern_lens);
+        return -1;
+    }
+
+    long long matches = 0;
+    long long global_pos = 0;
+    int state = 0;
+    int stopped = 0;
+
+    for (;;) {
+        long filled = fasta_stream_read(stream, buffer, buffer_size);
+        if (filled < 0) {
+            matches = -1;
+            break;
+        }
+        if (filled == 0 || stopped) break;
+
+        for (long i = 0; i < filled && !stopped; i++, global_pos++) {
+            int code = ac_code((unsigned char)buffer[i]);
+            if (code < 0) {
+                state = 0;
+                continue;
+            }
+            state = ac.states[state].next[code];
+
+            for (int s = (ac.states[state].output_count > 0) ? state : ac.states[state].dict_link;
+                 s >= 0; s = ac.states[s].dict_link) {
+                for (int j = 0; j < ac.states[s].output_count; j++) {
+                    int pattern_id = ac.states[s].output[j];
+                    matches++;
+                    if (on_match &&
+                        on_match(global_pos - pattern_lens[pattern_id] + 1,
+                                 pattern_id, user) < 0) {
+                        stopped = 1;
+                        break;
+                    }
+                }
+                if (stopped) break;
+            }
+        }
+    }
+
+    free(buffer);
+    fasta_stream_close(stream);
+    ac_free(&ac);
+    free(pattern_lens);
+
+    return matches;
+}
@@ -0,0 +1,221 @@
+/*
+ * Adaptive Algorithm Auto-Selection
+ *
+ * compare_all_algorithms() crowns a fastest algorithm per query and
+ * throws the knowledge away. This module keeps it: a calibration pass
+ * (run once per machine, e.g. `benchmark --calibrate`) times every
+ * exact matcher across pattern-length buckets on a synthetic DNA
+ * corpus and caches the per-algorithm costs on disk; auto_search()
+ * then dispatches each query to the cheapest matcher for its pattern
+ * length. Texts with a non-DNA alphabet or too small to amortize any
+ * preprocessing are routed by rule instead, and with no profile on
+ * disk a length heuristic applies - auto mode never fails, it only
+ * degrades toward a sensible default.
+ */
+
+#define _GNU_SOURCE
+#include "pattern_matching.h"
+
+#define AUTO_PROFILE_PATH "data/calibration.profile"
+#define AUTO_PROFILE_MAGIC "hashira-calibration-v1"
+
+#define AUTO_NUM_ALGOS 6          // Matches the SearchAlgorithm enum order
+#define AUTO_NUM_BUCKETS 4        // Pattern length: <=8, <=32, <=64, >64
+#define AUTO_CALIB_TEXT_LEN (1 << 20)
+#define AUTO_CALIB_REPS 3
+#define AUTO_SMALL_TEXT 4096      // Below this, setup cost dominates
+
+// Representative pattern length measured for each bucket
+static const int bucket_probe_m[AUTO_NUM_BUCKETS] = {6, 20, 48, 200};
+
+static const char *algo_names[AUTO_NUM_ALGOS] = {
+    "naive", "kmp", "boyer_moore", "rabin_karp", "z", "shift_or"
+};
+
+// Cached profile: milliseconds per calibration run, algo x bucket
+static double profile_ms[AUTO_NUM_ALGOS][AUTO_NUM_BUCKETS];
+static int profile_state = 0;  // 0 = not tried, 1 = loaded, -1 = unavailable
+
+const char* search_algorithm_name(SearchAlgorithm algo) {
+    if ((int)algo < 0 || (int)algo >= AUTO_NUM_ALGOS) return "unknown";
+    return algo_names[algo];
+}
+
+static int bucket_for_length(int m) {
+    if (m <= 8) return 0;
+    if (m <= 32) return 1;
+    if (m <= 64) return 2;
+    return 3;
+}
+
+// Same dispatch switch the parallel driver uses
+static MatchResult dispatch_algorithm(SearchAlgorithm algo, const char *text,
+                                      const char *pattern) {
+    switch (algo) {
+        case SEARCH_ALGO_NAIVE:       return naive_search(text, pattern);
+        case SEARCH_ALGO_KMP:         return kmp_search(text, pattern);
+        case SEARCH_ALGO_BOYER_MOORE: return boyer_moore_search(text, pattern);
+        case SEARCH_ALGO_RABIN_KARP:  return rabin_karp_search(text, pattern);
+        case SEARCH_ALGO_Z:           return z_algorithm_search(text, pattern);
+        default:                      return shift_or_search(text, pattern);
+    }
+}
+
+static double auto_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+// Loads the on-disk profile into profile_ms. Returns 0 on success.
+static int load_profile(const char *path) {
+    FILE *file = fopen(path, "r");
+    if (!file) return -1;
+
+    char magic[64];
+    if (fscanf(file, "%63s", magic) != 1 || strcmp(magic, AUTO_PROFILE_MAGIC) != 0) {
+        fclose(file);
+        return -1;
+    }
+
+    char name[32];
+    int bucket;
+    double ms;
+    int filled = 0;
+    while (fscanf(file, "%31s %d %lf", name, &bucket, &ms) == 3) {
+        if (bucket < 0 || bucket >= AUTO_NUM_BUCKETS) continue;
+        for (int a = 0; a < AUTO_NUM_ALGOS; a++) {
+            if (strcmp(name, algo_names[a]) == 0) {
+                profile_ms[a][bucket] = ms;
+                filled++;
+                break;
+            }
+        }
+    }
+    fclose(file);
+
+    return (filled == AUTO_NUM_ALGOS * AUTO_NUM_BUCKETS) ? 0 : -1;
+}
+
+// No profile: route by pattern length. Short patterns fit a Shift-Or
+// state word; everything else takes Boyer-Moore, whose DNA q-gram
+// kernel shifts close to m per window.
+static SearchAlgorithm heuristic_select(int m) {
+    if (m <= 4) return SEARCH_ALGO_SHIFT_OR;
+    return SEARCH_ALGO_BOYER_MOORE;
+}
+
+/**
+ * Measures every exact matcher across the pattern-length buckets on a
+ * 1 MB synthetic DNA corpus (min of 3 runs each) and writes the result
+ * to profile_path (NULL = data/calibration.profile). The in-memory
+ * profile is refreshed too, so the current process benefits at once.
+ * Returns: 0 on success, -1 on failure
+ */
+int calibrate_auto_search(const char *profile_path) {
+    if (!profile_path) profile_path = AUTO_PROFILE_PATH;
+
+    char *text = generate_random_dna(AUTO_CALIB_TEXT_LEN);
+    if (!text) return -1;
+
+    for (int b = 0; b < AUTO_NUM_BUCKETS; b++) {
+        // Probe pattern is a slice of the corpus so matchers do real work
+        int m = bucket_probe_m[b];
+        char pattern[256];
+        memcpy(pattern, text + AUTO_CALIB_TEXT_LEN / 2, m);
+        pattern[m] = '\0';
+
+        for (int a = 0; a < AUTO_NUM_ALGOS; a++) {
+            double best = -1.0;
+            for (int rep = 0; rep < AUTO_CALIB_REPS + 1; rep++) {
+                double t0 = auto_now_ms();
+                MatchResult result = dispatch_algorithm((SearchAlgorithm)a, text, pattern);
+                double elapsed = auto_now_ms() - t0;
+                free_match_result(&result);
+                // First run is warmup (page faults, branch history)
+                if (rep > 0 && (best < 0.0 || elapsed < best)) best = elapsed;
+            }
+            profile_ms[a][b] = best;
+        }
+    }
+    large_free(text);
+
+    FILE *file = fopen(profile_path, "w");
+    if (!file) {
+        fprintf(stderr, "Error: Cannot write calibration profile %s\n", profile_path);
+        return -1;
+    }
+    fprintf(file, "%s\n", AUTO_PROFILE_MAGIC);
+    for (int a = 0; a < AUTO_NUM_ALGOS; a++) {
+        for (int b = 0; b < AUTO_NUM_BUCKETS; b++) {
+            fprintf(file, "%s %d %.6f\n", algo_names[a], b, profile_ms[a][b]);
+        }
+    }
+    fclose(file);
+
+    profile_state = 1;
+    return 0;
+}
+
+// Lazily loads the cached profile; returns 1 when usable
+int auto_profile_available(void) {
+    if (profile_state == 0) {
+        profile_state = (load_profile(AUTO_PROFILE_PATH) == 0) ? 1 : -1;
+    }
+    return profile_state == 1;
+}
+
+/**
+ * Picks the matcher for this query from pattern length, text length
+ * and alphabet stats. DNA-sized alphabets use the calibration profile
+ * (or the length heuristic without one); texts with rich alphabets are
+ * routed to Boyer-Moore, whose bad-character shifts grow with alphabet
+ * size and which the DNA-tuned calibration says nothing about.
+ */
+SearchAlgorithm auto_select_algorithm(const char *text, size_t text_len,
+                                      const char *pattern) {
+    int m = pattern ? (int)strlen(pattern) : 0;
+
+    // Tiny text: preprocessing dominates, brute force wins
+    if (text_len < AUTO_SMALL_TEXT) return SEARCH_ALGO_NAIVE;
+
+    // Alphabet stats from a bounded sample
+    size_t sample = (text_len < 65536) ? text_len : 65536;
+    int seen[256] = {0};
+    int alphabet = 0;
+    for (size_t i = 0; i < sample; i++) {
+        if (!seen[(unsigned char)text[i]]) {
+            seen[(unsigned char)text[i]] = 1;
+            alphabet++;
+        }
+    }
+    if (alphabet > 8) {
+        return (m >= 4) ? SEARCH_ALGO_BOYER_MOORE : SEARCH_ALGO_KMP;
+    }
+
+    if (!auto_profile_available()) return heuristic_select(m);
+
+    int bucket = bucket_for_length(m);
+    SearchAlgorithm best = SEARCH_ALGO_KMP;
+    double best_ms = -1.0;
+    for (int a = 0; a < AUTO_NUM_ALGOS; a++) {
+        if (profile_ms[a][bucket] >= 0.0 &&
+            (best_ms < 0.0 || profile_ms[a][bucket] < best_ms)) {
+            best_ms = profile_ms[a][bucket];
+            best = (SearchAlgorithm)a;
+        }
+    }
+    return best;
+}
+
+// Auto mode: select, then dispatch. The chosen algorithm is available
+// via auto_select_algorithm() when callers want to report it.
+MatchResult auto_search(const char *text, size_t text_len, const char *pattern) {
+    MatchResult result;
+    init_match_result(&result);
+
+    if (!text || !pattern) return result;
+
+    return dispatch_algorithm(auto_select_algorithm(text, text_len, pattern),
+                              text, pattern);
+}
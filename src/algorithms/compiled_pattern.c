@@ -0,0 +1,734 @@
+/*
+ * Compiled-Pattern API
+ *
+ * Separates pattern preprocessing from searching: compile_pattern()
+ * builds the algorithm's tables (LPS array, bad-character/good-suffix
+ * tables, Shift-Or bitmasks, Rabin-Karp pattern hash) exactly once into
+ * a reusable handle, and search_compiled() runs the scan with zero
+ * per-call preprocessing or mallocs beyond the result array. The text
+ * length is passed explicitly, so no strlen pass either.
+ */
+
+#define _GNU_SOURCE
+#include "pattern_matching.h"
+#include <pthread.h>
+
+#define ALPHABET_SIZE 256
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+
+// Rabin-Karp uses the shared 64-bit Mersenne-prime hash primitives
+// (rk_mulmod / rk_pow_base), kept identical to rabin_karp_search()
+#define RK_BASE 256ULL
+
+struct CompiledPattern {
+    SearchAlgorithm algo;
+    char *pattern;
+    int m;
+
+    // KMP
+    int *lps;
+
+    // Boyer-Moore
+    int bad_char[ALPHABET_SIZE];
+    int *good_suffix;
+
+    // Shift-Or: single-word masks for m <= 64; blocked masks (one set
+    // of 256 per 64-bit word of pattern) for longer probes
+    unsigned long long so_mask[ALPHABET_SIZE];
+    unsigned long long so_match_bit;
+    unsigned long long *so_blocked_mask;  // blocks x 256, NULL for m <= 64
+    int so_blocks;
+
+    // Rabin-Karp
+    unsigned long long rk_pattern_hash;
+    unsigned long long rk_high_mul;  // BASE^(m-1) mod 2^61 - 1
+};
+
+// Per-match sink used by the search cores; returns -1 to abort (OOM)
+typedef int (*match_emit_fn)(int pos, void *user);
+
+/* ---- Length-aware search cores ---- */
+
+static int core_naive(const CompiledPattern *cp, const char *text, size_t n,
+                      match_emit_fn emit, void *user) {
+    size_t m = (size_t)cp->m;
+    for (size_t i = 0; i + m <= n; i++) {
+        if (memcmp(text + i, cp->pattern, m) == 0) {
+            if (emit((int)i, user) < 0) return -1;
+        }
+    }
+    return 0;
+}
+
+static int core_kmp(const CompiledPattern *cp, const char *text, size_t n,
+                    match_emit_fn emit, void *user) {
+    int m = cp->m;
+    size_t i = 0;
+    int j = 0;
+
+    while (i < n) {
+        if (cp->pattern[j] == text[i]) {
+            i++;
+            j++;
+        }
+
+        if (j == m) {
+            if (emit((int)(i - j), user) < 0) return -1;
+            j = cp->lps[j - 1];
+        } else if (i < n && cp->pattern[j] != text[i]) {
+            if (j != 0) {
+                j = cp->lps[j - 1];
+            } else {
+                i++;
+            }
+        }
+    }
+    return 0;
+}
+
+static int core_boyer_moore(const CompiledPattern *cp, const char *text, size_t n,
+                            match_emit_fn emit, void *user) {
+    int m = cp->m;
+    size_t shift = 0;
+
+    while (shift + m <= n) {
+        int j = m - 1;
+        while (j >= 0 && cp->pattern[j] == text[shift + j]) {
+            j--;
+        }
+
+        if (j < 0) {
+            if (emit((int)shift, user) < 0) return -1;
+            shift += (shift + m < n)
+                     ? m - cp->bad_char[(unsigned char)text[shift + m]] : 1;
+        } else {
+            int bad_char_shift = j - cp->bad_char[(unsigned char)text[shift + j]];
+            int good_suffix_shift = cp->good_suffix[j];
+            shift += MAX(bad_char_shift, good_suffix_shift);
+        }
+    }
+    return 0;
+}
+
+static int core_rabin_karp(const CompiledPattern *cp, const char *text, size_t n,
+                           match_emit_fn emit, void *user) {
+    size_t m = (size_t)cp->m;
+    if (m > n) return 0;
+
+    unsigned long long text_hash = 0;
+    for (size_t i = 0; i < m; i++) {
+        text_hash = rk_mulmod(text_hash, RK_BASE);
+        text_hash = (text_hash + (unsigned char)text[i]) % RK_MERSENNE_P;
+    }
+
+    for (size_t i = 0; i + m <= n; i++) {
+        // 61-bit fingerprints collide ~never; the memcmp fires only on
+        // true matches in practice but keeps the result exact
+        if (text_hash == cp->rk_pattern_hash &&
+            memcmp(text + i, cp->pattern, m) == 0) {
+            if (emit((int)i, user) < 0) return -1;
+        }
+
+        if (i + m < n) {
+            unsigned long long old_char = rk_mulmod((unsigned char)text[i], cp->rk_high_mul);
+            text_hash = (text_hash + RK_MERSENNE_P - old_char) % RK_MERSENNE_P;
+            text_hash = rk_mulmod(text_hash, RK_BASE);
+            text_hash = (text_hash + (unsigned char)text[i + m]) % RK_MERSENNE_P;
+        }
+    }
+    return 0;
+}
+
+static int core_shift_or(const CompiledPattern *cp, const char *text, size_t n,
+                         match_emit_fn emit, void *user) {
+    // Blocked path for m > 64: state spans so_blocks words with carry
+    // propagation, same loop as shift_or_search_blocked(). Only the
+    // per-call state words are allocated here - the masks live in the
+    // compiled handle
+    if (cp->so_blocks > 1) {
+        int blocks = cp->so_blocks;
+        unsigned long long *state = (unsigned long long *)malloc(
+            blocks * sizeof(unsigned long long));
+        if (!state) return -1;
+        for (int b = 0; b < blocks; b++) {
+            state[b] = ~0ULL;
+        }
+
+        for (size_t i = 0; i < n; i++) {
+            unsigned char c = (unsigned char)text[i];
+            unsigned long long carry = 0;
+            for (int b = 0; b < blocks; b++) {
+                unsigned long long top = state[b] >> 63;
+                state[b] = ((state[b] << 1) | carry) |
+                           cp->so_blocked_mask[(size_t)b * ALPHABET_SIZE + c];
+                carry = top;
+            }
+            if ((state[blocks - 1] & cp->so_match_bit) == 0) {
+                if (emit((int)(i - cp->m + 1), user) < 0) {
+                    free(state);
+                    return -1;
+                }
+            }
+        }
+        free(state);
+        return 0;
+    }
+
+    unsigned long long state = ~0ULL;
+
+    for (size_t i = 0; i < n; i++) {
+        state = (state << 1) | cp->so_mask[(unsigned char)text[i]];
+        if ((state & cp->so_match_bit) == 0) {
+            if (emit((int)(i - cp->m + 1), user) < 0) return -1;
+        }
+    }
+    return 0;
+}
+
+// Dispatch table shared by search_compiled() and future streaming users
+static int run_core(const CompiledPattern *cp, const char *text, size_t n,
+                    match_emit_fn emit, void *user) {
+    switch (cp->algo) {
+        case SEARCH_ALGO_NAIVE:       return core_naive(cp, text, n, emit, user);
+        case SEARCH_ALGO_KMP:         return core_kmp(cp, text, n, emit, user);
+        case SEARCH_ALGO_BOYER_MOORE: return core_boyer_moore(cp, text, n, emit, user);
+        case SEARCH_ALGO_RABIN_KARP:  return core_rabin_karp(cp, text, n, emit, user);
+        case SEARCH_ALGO_SHIFT_OR:    return core_shift_or(cp, text, n, emit, user);
+        case SEARCH_ALGO_Z:           break;  // Rejected at compile_pattern()
+    }
+    return 0;
+}
+
+/* ---- Public API ---- */
+
+/**
+ * Builds the preprocessing tables for the chosen algorithm once.
+ * Returns an opaque handle, or NULL on failure / unsupported algorithm.
+ */
+CompiledPattern* compile_pattern(const char *pattern, SearchAlgorithm algo) {
+    if (!pattern) return NULL;
+
+    int m = strlen(pattern);
+    if (m == 0) return NULL;
+
+    if (algo == SEARCH_ALGO_Z) {
+        // Z builds its array over pattern$text, so there is nothing
+        // text-independent to reuse; pick KMP for precompiled scans
+        fprintf(stderr, "compile_pattern: Z-Algorithm has no reusable preprocessing\n");
+        return NULL;
+    }
+    CompiledPattern *cp = (CompiledPattern *)calloc(1, sizeof(CompiledPattern));
+    if (!cp) return NULL;
+
+    cp->algo = algo;
+    cp->m = m;
+    cp->pattern = strdup(pattern);
+    if (!cp->pattern) {
+        free(cp);
+        return NULL;
+    }
+
+    switch (algo) {
+        case SEARCH_ALGO_KMP:
+            cp->lps = (int *)malloc(m * sizeof(int));
+            if (!cp->lps) {
+                free_compiled_pattern(cp);
+                return NULL;
+            }
+            compute_lps_array(pattern, m, cp->lps);
+            break;
+
+        case SEARCH_ALGO_BOYER_MOORE:
+            compute_bad_character(pattern, m, cp->bad_char);
+            cp->good_suffix = (int *)malloc(m * sizeof(int));
+            if (!cp->good_suffix) {
+                free_compiled_pattern(cp);
+                return NULL;
+            }
+            compute_good_suffix(pattern, m, cp->good_suffix);
+            break;
+
+        case SEARCH_ALGO_SHIFT_OR:
+            if (m > 64) {
+                // Blocked masks, same layout shift_or_search_blocked()
+                // builds per call - text-independent, so compiled once
+                cp->so_blocks = (m + 63) / 64;
+                cp->so_blocked_mask = (unsigned long long *)malloc(
+                    (size_t)cp->so_blocks * ALPHABET_SIZE * sizeof(unsigned long long));
+                if (!cp->so_blocked_mask) {
+                    free_compiled_pattern(cp);
+                    return NULL;
+                }
+                for (size_t i = 0; i < (size_t)cp->so_blocks * ALPHABET_SIZE; i++) {
+                    cp->so_blocked_mask[i] = ~0ULL;
+                }
+                for (int i = 0; i < m; i++) {
+                    cp->so_blocked_mask[(size_t)(i / 64) * ALPHABET_SIZE +
+                                        (unsigned char)pattern[i]] &= ~(1ULL << (i % 64));
+                }
+                cp->so_match_bit = 1ULL << ((m - 1) % 64);
+                break;
+            }
+            cp->so_blocks = 1;
+            for (int i = 0; i < ALPHABET_SIZE; i++) {
+                cp->so_mask[i] = ~0ULL;
+            }
+            for (int i = 0; i < m; i++) {
+                cp->so_mask[(unsigned char)pattern[i]] &= ~(1ULL << i);
+            }
+            cp->so_match_bit = 1ULL << (m - 1);
+            break;
+
+        case SEARCH_ALGO_RABIN_KARP:
+            cp->rk_high_mul = rk_pow_base(m - 1);
+            cp->rk_pattern_hash = 0;
+            for (int i = 0; i < m; i++) {
+                cp->rk_pattern_hash = rk_mulmod(cp->rk_pattern_hash, RK_BASE);
+                cp->rk_pattern_hash = (cp->rk_pattern_hash +
+                                       (unsigned char)pattern[i]) % RK_MERSENNE_P;
+            }
+            break;
+
+        case SEARCH_ALGO_NAIVE:
+        case SEARCH_ALGO_Z:
+            break;
+    }
+
+    return cp;
+}
+
+// Chunked position list fed by the emit callback. Fixed-size blocks are
+// chained instead of realloc-doubled: a query with millions of matches
+// never recopies what it already collected (realloc doubling copies the
+// whole array ~20 times for 50M matches), and the final array is sized
+// exactly - positions move once, from block to result.
+#define COLLECT_BLOCK_POSITIONS 65536
+
+typedef struct CollectBlock {
+    struct CollectBlock *next;
+    int count;
+    int positions[COLLECT_BLOCK_POSITIONS];
+} CollectBlock;
+
+typedef struct {
+    CollectBlock *head;      // Block list in collection order
+    CollectBlock *tail;      // Block currently being filled
+    long long total;
+} MatchCollector;
+
+static int collect_match(int pos, void *user) {
+    MatchCollector *collector = (MatchCollector *)user;
+
+    if (!collector->tail || collector->tail->count == COLLECT_BLOCK_POSITIONS) {
+        CollectBlock *block = (CollectBlock *)malloc(sizeof(CollectBlock));
+        if (!block) return -1;
+        block->next = NULL;
+        block->count = 0;
+        if (collector->tail) {
+            collector->tail->next = block;
+        } else {
+            collector->head = block;
+        }
+        collector->tail = block;
+    }
+    collector->tail->positions[collector->tail->count++] = pos;
+    collector->total++;
+    return 0;
+}
+
+static void collector_free_blocks(MatchCollector *collector) {
+    CollectBlock *block = collector->head;
+    while (block) {
+        CollectBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+    collector->head = collector->tail = NULL;
+}
+
+// Assembles the blocks into one exactly-sized array (single pass)
+static int* collector_to_array(MatchCollector *collector) {
+    int *positions = (int *)malloc((collector->total > 0 ? collector->total : 1) * sizeof(int));
+    if (!positions) return NULL;
+
+    long long at = 0;
+    for (CollectBlock *block = collector->head; block; block = block->next) {
+        memcpy(positions + at, block->positions, block->count * sizeof(int));
+        at += block->count;
+    }
+    return positions;
+}
+
+/**
+ * Runs a precompiled pattern over text of explicit length: no strlen,
+ * no per-call preprocessing, no reallocation churn on match-dense text.
+ */
+MatchResult search_compiled(const CompiledPattern *handle, const char *text, size_t text_len) {
+    MatchResult result;
+    init_match_result(&result);
+
+    if (!handle || !text) {
+        return result;
+    }
+
+    PerfTimer timer;
+    perf_timer_start(&timer);
+
+    if ((size_t)handle->m > text_len) {
+        perf_timer_stop(&timer, &result);
+        return result;
+    }
+
+    MatchCollector collector;
+    collector.head = collector.tail = NULL;
+    collector.total = 0;
+
+    if (run_core(handle, text, text_len, collect_match, &collector) < 0) {
+        collector_free_blocks(&collector);
+        fprintf(stderr, "Memory allocation failed\n");
+        perf_timer_stop(&timer, &result);
+        return result;
+    }
+
+    int *positions = collector_to_array(&collector);
+    collector_free_blocks(&collector);
+    if (!positions) {
+        fprintf(stderr, "Memory allocation failed\n");
+        perf_timer_stop(&timer, &result);
+        return result;
+    }
+
+    perf_timer_stop(&timer, &result);
+
+    result.positions = positions;
+    result.count = (int)collector.total;
+    result.memory_used = collector.total * sizeof(int);
+
+    return result;
+}
+
+// Adapts the core emit (int position) to the public callback signature
+typedef struct {
+    CompiledMatchFn on_match;
+    void *user;
+    long long emitted;
+    int aborted;
+} CallbackAdapter;
+
+static int callback_emit(int pos, void *user) {
+    CallbackAdapter *adapter = (CallbackAdapter *)user;
+    adapter->emitted++;
+    if (adapter->on_match && adapter->on_match(pos, adapter->user) < 0) {
+        adapter->aborted = 1;
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Callback delivery: every match position goes straight to on_match with
+ * no position array built at all - nothing is allocated per match, so
+ * match-dense queries cost zero memory beyond the handle. on_match may be
+ * NULL to count only; returning < 0 from it stops the search early.
+ * Returns: number of matches delivered, or -1 on error
+ */
+long long search_compiled_cb(const CompiledPattern *handle, const char *text,
+                             size_t text_len, CompiledMatchFn on_match, void *user) {
+    if (!handle || !text) return -1;
+    if ((size_t)handle->m > text_len) return 0;
+
+    CallbackAdapter adapter;
+    adapter.on_match = on_match;
+    adapter.user = user;
+    adapter.emitted = 0;
+    adapter.aborted = 0;
+
+    run_core(handle, text, text_len, callback_emit, &adapter);
+    return adapter.emitted;
+}
+
+/**
+ * One-shot callback search: compiles, scans, frees. Z-Algorithm is not
+ * supported (same reason as compile_pattern()).
+ * Returns: number of matches delivered, or -1 on error
+ */
+long long search_cb(SearchAlgorithm algo, const char *text, size_t text_len,
+                    const char *pattern, CompiledMatchFn on_match, void *user) {
+    CompiledPattern *handle = compile_pattern(pattern, algo);
+    if (!handle) return -1;
+
+    long long matches = search_compiled_cb(handle, text, text_len, on_match, user);
+    free_compiled_pattern(handle);
+    return matches;
+}
+
+// Adapts the core emit (buffer-local int) to global stream coordinates
+typedef struct {
+    long long window_base;   // Global position of the window's first byte
+    CompiledMatchFn on_match;
+    void *user;
+    long long emitted;
+    int aborted;
+} StreamAdapter;
+
+static int stream_emit(int pos, void *user) {
+    StreamAdapter *adapter = (StreamAdapter *)user;
+    adapter->emitted++;
+    if (adapter->on_match &&
+        adapter->on_match(adapter->window_base + pos, adapter->user) < 0) {
+        adapter->aborted = 1;
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Streams a FASTA file through a precompiled pattern in fixed-size
+ * windows with (m-1)-byte carry-over, so inputs far larger than RAM are
+ * searched at disk speed. Windows overlap by m-1 bytes and a match of
+ * length m cannot fit inside the overlap, so every match is reported
+ * exactly once, in order, with global sequence coordinates.
+ * buffer_size 0 uses a 4 MB default. on_match may be NULL to count only;
+ * returning < 0 from it stops the stream early.
+ * Returns: number of matches, or -1 on error
+ */
+long long stream_search_file(const CompiledPattern *handle, const char *filename,
+                             size_t buffer_size, CompiledMatchFn on_match, void *user) {
+    if (!handle || !filename) return -1;
+
+    if (buffer_size == 0) buffer_size = 4 * 1024 * 1024;
+    size_t m = (size_t)handle->m;
+    if (buffer_size < 2 * m) buffer_size = 2 * m;  // Window must dominate the carry
+
+    FastaStream *stream = fasta_stream_open(filename);
+    if (!stream) return -1;
+
+    // Layout: [carry of up to m-1 bytes][freshly streamed bases]
+    char *window = (char *)malloc(buffer_size);
+    if (!window) {
+        fasta_stream_close(stream);
+        return -1;
+    }
+
+    StreamAdapter adapter;
+    adapter.on_match = on_match;
+    adapter.user = user;
+    adapter.emitted = 0;
+    adapter.aborted = 0;
+
+    size_t carry = 0;
+    long long global_offset = 0;  // Global position of window[0]
+
+    for (;;) {
+        long filled = fasta_stream_read(stream, window + carry, buffer_size - carry);
+        if (filled < 0) {
+            free(window);
+            fasta_stream_close(stream);
+            return -1;
+        }
+        if (filled == 0) break;
+
+        size_t window_len = carry + (size_t)filled;
+        adapter.window_base = global_offset;
+        if (run_core(handle, window, window_len, stream_emit, &adapter) < 0 ||
+            adapter.aborted) {
+            break;
+        }
+
+        // Carry the last m-1 bytes so boundary-spanning matches are seen
+        size_t next_carry = (window_len >= m) ? m - 1 : window_len;
+        memmove(window, window + window_len - next_carry, next_carry);
+        global_offset += (long long)(window_len - next_carry);
+        carry = next_carry;
+    }
+
+    free(window);
+    fasta_stream_close(stream);
+    return adapter.emitted;
+}
+
+/* ---- Pipelined streaming: overlap FASTA parsing with the search ---- */
+
+// Ring of parsed chunks between the reader thread and the searching
+// consumer. Each buffer reserves carry_max prefix bytes so the consumer
+// can prepend the previous window's tail without copying the chunk.
+#define PIPE_RING_SLOTS 4
+
+typedef struct {
+    char *buffers[PIPE_RING_SLOTS];
+    long lens[PIPE_RING_SLOTS];   // Payload bytes the reader filled
+    int head;                     // Next slot the reader fills
+    int tail;                     // Next slot the consumer takes
+    int count;
+    int eof;
+    int error;
+    int stop;                     // Consumer aborted; reader should quit
+    FastaStream *stream;
+    size_t buffer_size;
+    size_t carry_max;
+    pthread_mutex_t lock;
+    pthread_cond_t not_full;
+    pthread_cond_t not_empty;
+} PipeRing;
+
+// Reader thread body: parse FASTA chunks into free ring slots until
+// EOF, error, or the consumer tells us to stop
+static void* pipe_reader(void *arg) {
+    PipeRing *ring = (PipeRing *)arg;
+
+    for (;;) {
+        pthread_mutex_lock(&ring->lock);
+        while (ring->count == PIPE_RING_SLOTS && !ring->stop) {
+            pthread_cond_wait(&ring->not_full, &ring->lock);
+        }
+        if (ring->stop) {
+            pthread_mutex_unlock(&ring->lock);
+            return NULL;
+        }
+        int slot = ring->head;
+        pthread_mutex_unlock(&ring->lock);
+
+        // Parse outside the lock - this is the overlap that matters
+        long filled = fasta_stream_read(ring->stream,
+                                        ring->buffers[slot] + ring->carry_max,
+                                        ring->buffer_size);
+
+        pthread_mutex_lock(&ring->lock);
+        if (filled < 0) {
+            ring->error = 1;
+        } else if (filled == 0) {
+            ring->eof = 1;
+        } else {
+            ring->lens[slot] = filled;
+            ring->head = (ring->head + 1) % PIPE_RING_SLOTS;
+            ring->count++;
+        }
+        pthread_cond_signal(&ring->not_empty);
+        int done = ring->error || ring->eof;
+        pthread_mutex_unlock(&ring->lock);
+
+        if (done) return NULL;
+    }
+}
+
+/**
+ * Pipelined variant of stream_search_file(): a reader thread parses
+ * FASTA chunks into a ring of buffers while this thread searches them,
+ * so total wall time approaches max(I/O, search) instead of their sum.
+ * Same semantics as the serial version: global match coordinates,
+ * carry-over across chunk boundaries, NULL callback counts only.
+ * Returns: number of matches delivered, or -1 on error
+ */
+long long stream_search_file_pipelined(const CompiledPattern *handle, const char *filename,
+                                       size_t buffer_size, CompiledMatchFn on_match,
+                                       void *user) {
+    if (!handle || !filename) return -1;
+
+    if (buffer_size == 0) buffer_size = 4 * 1024 * 1024;
+    size_t m = (size_t)handle->m;
+    if (buffer_size < 2 * m) buffer_size = 2 * m;
+
+    PipeRing ring;
+    memset(&ring, 0, sizeof(ring));
+    ring.buffer_size = buffer_size;
+    ring.carry_max = (m > 0) ? m - 1 : 0;
+
+    ring.stream = fasta_stream_open(filename);
+    if (!ring.stream) return -1;
+
+    int ok = 1;
+    for (int i = 0; i < PIPE_RING_SLOTS; i++) {
+        ring.buffers[i] = (char *)malloc(ring.carry_max + buffer_size);
+        if (!ring.buffers[i]) ok = 0;
+    }
+    pthread_mutex_init(&ring.lock, NULL);
+    pthread_cond_init(&ring.not_full, NULL);
+    pthread_cond_init(&ring.not_empty, NULL);
+
+    pthread_t reader;
+    if (!ok || pthread_create(&reader, NULL, pipe_reader, &ring) != 0) {
+        // No pipeline possible: fall back to the serial path
+        for (int i = 0; i < PIPE_RING_SLOTS; i++) free(ring.buffers[i]);
+        fasta_stream_close(ring.stream);
+        pthread_mutex_destroy(&ring.lock);
+        pthread_cond_destroy(&ring.not_full);
+        pthread_cond_destroy(&ring.not_empty);
+        return stream_search_file(handle, filename, buffer_size, on_match, user);
+    }
+
+    StreamAdapter adapter;
+    adapter.on_match = on_match;
+    adapter.user = user;
+    adapter.emitted = 0;
+    adapter.aborted = 0;
+
+    char *carry_buf = (char *)malloc(ring.carry_max > 0 ? ring.carry_max : 1);
+    size_t carry = 0;
+    long long global_offset = 0;
+    int failed = (carry_buf == NULL);
+
+    while (!failed) {
+        pthread_mutex_lock(&ring.lock);
+        while (ring.count == 0 && !ring.eof && !ring.error) {
+            pthread_cond_wait(&ring.not_empty, &ring.lock);
+        }
+        if (ring.count == 0) {
+            // Drained; reader hit EOF or failed
+            failed = ring.error;
+            pthread_mutex_unlock(&ring.lock);
+            break;
+        }
+        int slot = ring.tail;
+        pthread_mutex_unlock(&ring.lock);
+
+        // Window = [previous carry][chunk payload], searched outside the lock
+        char *window = ring.buffers[slot] + ring.carry_max - carry;
+        size_t window_len = carry + (size_t)ring.lens[slot];
+        memcpy(window, carry_buf, carry);
+
+        adapter.window_base = global_offset;
+        int core_failed = (run_core(handle, window, window_len, stream_emit, &adapter) < 0);
+
+        size_t next_carry = (window_len >= m) ? m - 1 : window_len;
+        memcpy(carry_buf, window + window_len - next_carry, next_carry);
+        global_offset += (long long)(window_len - next_carry);
+        carry = next_carry;
+
+        pthread_mutex_lock(&ring.lock);
+        ring.tail = (ring.tail + 1) % PIPE_RING_SLOTS;
+        ring.count--;
+        if (core_failed || adapter.aborted) ring.stop = 1;
+        pthread_cond_signal(&ring.not_full);
+        pthread_mutex_unlock(&ring.lock);
+
+        if (core_failed || adapter.aborted) break;
+    }
+
+    if (failed) {
+        pthread_mutex_lock(&ring.lock);
+        ring.stop = 1;
+        pthread_cond_signal(&ring.not_full);
+        pthread_mutex_unlock(&ring.lock);
+    }
+
+    pthread_join(reader, NULL);
+
+    free(carry_buf);
+    for (int i = 0; i < PIPE_RING_SLOTS; i++) free(ring.buffers[i]);
+    fasta_stream_close(ring.stream);
+    pthread_mutex_destroy(&ring.lock);
+    pthread_cond_destroy(&ring.not_full);
+    pthread_cond_destroy(&ring.not_empty);
+
+    return failed ? -1 : adapter.emitted;
+}
+
+void free_compiled_pattern(CompiledPattern *handle) {
+    if (!handle) return;
+
+    free(handle->pattern);
+    free(handle->lps);
+    free(handle->good_suffix);
+    free(handle->so_blocked_mask);
+    free(handle);
+}
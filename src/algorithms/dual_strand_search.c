@@ -0,0 +1,324 @@
+/*
+ * Dual-Strand Search
+ *
+ * Biological queries need both strands: the pattern and its reverse
+ * complement. Instead of scanning the text twice and merging externally,
+ * dual_strand_search() runs both patterns in a single pass where the
+ * algorithm allows it - paired automata for KMP, paired state words for
+ * Shift-Or, one rolling hash against two fingerprints for Rabin-Karp,
+ * two compares per window for naive. Boyer-Moore and Z (and Shift-Or
+ * beyond 64 characters) shift differently per pattern, so those run one
+ * scan per strand and merge the sorted results.
+ *
+ * Palindromic patterns (equal to their reverse complement) match both
+ * strands at every hit; they are searched once and reported as '+'.
+ */
+
+#include "pattern_matching.h"
+
+#define ALPHABET_SIZE 256
+
+// Growable (position, strand) pair list shared by all strategies
+typedef struct {
+    int *positions;
+    char *strands;
+    int count;
+    int capacity;
+    size_t memory_used;
+} StrandCollector;
+
+static int strand_collector_init(StrandCollector *c) {
+    c->capacity = 100;
+    c->count = 0;
+    c->positions = (int *)malloc(c->capacity * sizeof(int));
+    c->strands = (char *)malloc(c->capacity * sizeof(char));
+    if (!c->positions || !c->strands) {
+        free(c->positions);
+        free(c->strands);
+        fprintf(stderr, "Memory allocation failed\n");
+        return -1;
+    }
+    c->memory_used = c->capacity * (sizeof(int) + sizeof(char));
+    return 0;
+}
+
+static int strand_append(StrandCollector *c, int pos, char strand) {
+    if (c->count >= c->capacity) {
+        c->capacity *= 2;
+        int *p = (int *)realloc(c->positions, c->capacity * sizeof(int));
+        char *s = (char *)realloc(c->strands, c->capacity * sizeof(char));
+        if (!p || !s) {
+            free(p ? p : c->positions);
+            free(s ? s : c->strands);
+            c->positions = NULL;
+            c->strands = NULL;
+            fprintf(stderr, "Memory reallocation failed\n");
+            return -1;
+        }
+        c->positions = p;
+        c->strands = s;
+        c->memory_used = c->capacity * (sizeof(int) + sizeof(char));
+    }
+    c->positions[c->count] = pos;
+    c->strands[c->count] = strand;
+    c->count++;
+    return 0;
+}
+
+/* ---- Single-pass paired strategies ---- */
+
+// Two KMP automata advanced over the same text scan
+static int dual_kmp(const char *text, int n, const char *fwd, const char *rev,
+                    int m, StrandCollector *out) {
+    int *lps_fwd = (int *)malloc(m * sizeof(int));
+    int *lps_rev = (int *)malloc(m * sizeof(int));
+    if (!lps_fwd || !lps_rev) {
+        free(lps_fwd);
+        free(lps_rev);
+        fprintf(stderr, "Memory allocation failed\n");
+        return -1;
+    }
+    compute_lps_array(fwd, m, lps_fwd);
+    compute_lps_array(rev, m, lps_rev);
+
+    int jf = 0, jr = 0;
+    for (int i = 0; i < n; i++) {
+        char c = text[i];
+
+        while (jf > 0 && fwd[jf] != c) jf = lps_fwd[jf - 1];
+        if (fwd[jf] == c) jf++;
+        if (jf == m) {
+            if (strand_append(out, i - m + 1, '+') < 0) goto fail;
+            jf = lps_fwd[jf - 1];
+        }
+
+        while (jr > 0 && rev[jr] != c) jr = lps_rev[jr - 1];
+        if (rev[jr] == c) jr++;
+        if (jr == m) {
+            if (strand_append(out, i - m + 1, '-') < 0) goto fail;
+            jr = lps_rev[jr - 1];
+        }
+    }
+
+    free(lps_fwd);
+    free(lps_rev);
+    return 0;
+
+fail:
+    free(lps_fwd);
+    free(lps_rev);
+    return -1;
+}
+
+// Two Shift-Or state words updated per character (m <= 64)
+static int dual_shift_or(const char *text, int n, const char *fwd, const char *rev,
+                         int m, StrandCollector *out) {
+    unsigned long long mask_fwd[ALPHABET_SIZE], mask_rev[ALPHABET_SIZE];
+    for (int i = 0; i < ALPHABET_SIZE; i++) {
+        mask_fwd[i] = ~0ULL;
+        mask_rev[i] = ~0ULL;
+    }
+    for (int i = 0; i < m; i++) {
+        mask_fwd[(unsigned char)fwd[i]] &= ~(1ULL << i);
+        mask_rev[(unsigned char)rev[i]] &= ~(1ULL << i);
+    }
+
+    unsigned long long state_fwd = ~0ULL, state_rev = ~0ULL;
+    unsigned long long match_bit = 1ULL << (m - 1);
+
+    for (int i = 0; i < n; i++) {
+        unsigned char c = (unsigned char)text[i];
+        state_fwd = (state_fwd << 1) | mask_fwd[c];
+        state_rev = (state_rev << 1) | mask_rev[c];
+
+        if ((state_fwd & match_bit) == 0) {
+            if (strand_append(out, i - m + 1, '+') < 0) return -1;
+        }
+        if ((state_rev & match_bit) == 0) {
+            if (strand_append(out, i - m + 1, '-') < 0) return -1;
+        }
+    }
+    return 0;
+}
+
+// One window scan, both patterns compared per candidate
+static int dual_naive(const char *text, int n, const char *fwd, const char *rev,
+                      int m, StrandCollector *out) {
+    for (int i = 0; i + m <= n; i++) {
+        if (memcmp(text + i, fwd, m) == 0) {
+            if (strand_append(out, i, '+') < 0) return -1;
+        }
+        if (memcmp(text + i, rev, m) == 0) {
+            if (strand_append(out, i, '-') < 0) return -1;
+        }
+    }
+    return 0;
+}
+
+// One rolling hash, checked against both pattern fingerprints
+static int dual_rabin_karp(const char *text, int n, const char *fwd, const char *rev,
+                           int m, StrandCollector *out) {
+    unsigned long long h = rk_pow_base(m - 1);
+    unsigned long long hash_fwd = 0, hash_rev = 0, text_hash = 0;
+    for (int i = 0; i < m; i++) {
+        hash_fwd = (rk_mulmod(hash_fwd, 256) + (unsigned char)fwd[i]) % RK_MERSENNE_P;
+        hash_rev = (rk_mulmod(hash_rev, 256) + (unsigned char)rev[i]) % RK_MERSENNE_P;
+        text_hash = (rk_mulmod(text_hash, 256) + (unsigned char)text[i]) % RK_MERSENNE_P;
+    }
+
+    for (int i = 0; i + m <= n; i++) {
+        if (text_hash == hash_fwd && memcmp(text + i, fwd, m) == 0) {
+            if (strand_append(out, i, '+') < 0) return -1;
+        }
+        if (text_hash == hash_rev && memcmp(text + i, rev, m) == 0) {
+            if (strand_append(out, i, '-') < 0) return -1;
+        }
+        if (i + m < n) {
+            unsigned long long drop = rk_mulmod((unsigned char)text[i], h);
+            text_hash = (text_hash + RK_MERSENNE_P - drop) % RK_MERSENNE_P;
+            text_hash = rk_mulmod(text_hash, 256);
+            text_hash = (text_hash + (unsigned char)text[i + m]) % RK_MERSENNE_P;
+        }
+    }
+    return 0;
+}
+
+/* ---- Two-pass fallback ---- */
+
+// For matchers whose shift tables are pattern-specific (Boyer-Moore, Z):
+// one scan per strand, then a sorted merge of the two position lists
+static int dual_two_pass(SearchAlgorithm algo, const char *text, const char *fwd,
+                         const char *rev, StrandCollector *out) {
+    MatchResult rf, rr;
+
+    switch (algo) {
+        case SEARCH_ALGO_BOYER_MOORE:
+            rf = boyer_moore_search(text, fwd);
+            rr = boyer_moore_search(text, rev);
+            break;
+        case SEARCH_ALGO_Z:
+            rf = z_algorithm_search(text, fwd);
+            rr = z_algorithm_search(text, rev);
+            break;
+        default:  // Shift-Or beyond one word
+            rf = shift_or_search(text, fwd);
+            rr = shift_or_search(text, rev);
+            break;
+    }
+
+    int i = 0, j = 0;
+    while (i < rf.count || j < rr.count) {
+        int take_fwd = (j >= rr.count) ||
+                       (i < rf.count && rf.positions[i] <= rr.positions[j]);
+        if (take_fwd) {
+            if (strand_append(out, rf.positions[i++], '+') < 0) goto fail;
+        } else {
+            if (strand_append(out, rr.positions[j++], '-') < 0) goto fail;
+        }
+    }
+
+    free_match_result(&rf);
+    free_match_result(&rr);
+    return 0;
+
+fail:
+    free_match_result(&rf);
+    free_match_result(&rr);
+    return -1;
+}
+
+/**
+ * Searches text for the pattern on both strands, reporting each match
+ * position with its strand ('+' forward, '-' reverse complement).
+ * Returns an empty result on failure.
+ */
+StrandMatchResult dual_strand_search(SearchAlgorithm algo, const char *text,
+                                     const char *pattern) {
+    StrandMatchResult result;
+    result.positions = NULL;
+    result.strands = NULL;
+    result.count = 0;
+    result.time_taken = 0.0;
+    result.memory_used = 0;
+
+    if (!text || !pattern) {
+        return result;
+    }
+
+    clock_t start = clock();
+
+    int n = strlen(text);
+    int m = strlen(pattern);
+    if (m == 0 || m > n) {
+        result.time_taken = ((double)(clock() - start)) / CLOCKS_PER_SEC * 1000.0;
+        return result;
+    }
+
+    char *rev = reverse_complement(pattern);
+    if (!rev) {
+        return result;
+    }
+
+    StrandCollector out;
+    if (strand_collector_init(&out) < 0) {
+        free(rev);
+        return result;
+    }
+
+    int rc;
+    if (strcmp(rev, pattern) == 0) {
+        // Palindromic: one machine covers both strands, report once
+        rc = dual_kmp(text, n, pattern, pattern, m, &out);
+        if (rc == 0) {
+            // dual_kmp ran both machines over the same pattern; drop the
+            // duplicate '-' entries it produced
+            int w = 0;
+            for (int i = 0; i < out.count; i++) {
+                if (out.strands[i] == '+') {
+                    out.positions[w] = out.positions[i];
+                    out.strands[w] = '+';
+                    w++;
+                }
+            }
+            out.count = w;
+        }
+    } else {
+        switch (algo) {
+            case SEARCH_ALGO_NAIVE:
+                rc = dual_naive(text, n, pattern, rev, m, &out);
+                break;
+            case SEARCH_ALGO_KMP:
+                rc = dual_kmp(text, n, pattern, rev, m, &out);
+                break;
+            case SEARCH_ALGO_RABIN_KARP:
+                rc = dual_rabin_karp(text, n, pattern, rev, m, &out);
+                break;
+            case SEARCH_ALGO_SHIFT_OR:
+                rc = (m <= 64) ? dual_shift_or(text, n, pattern, rev, m, &out)
+                               : dual_two_pass(algo, text, pattern, rev, &out);
+                break;
+            case SEARCH_ALGO_BOYER_MOORE:
+            case SEARCH_ALGO_Z:
+            default:
+                rc = dual_two_pass(algo, text, pattern, rev, &out);
+                break;
+        }
+    }
+
+    free(rev);
+    if (rc < 0) {
+        free(out.positions);
+        free(out.strands);
+        return result;
+    }
+
+    clock_t end = clock();
+
+    result.positions = out.positions;
+    result.strands = out.strands;
+    result.count = out.count;
+    result.time_taken = ((double)(end - start)) / CLOCKS_PER_SEC * 1000.0;
+    result.memory_used = out.memory_used;
+
+    return result;
+}
@@ -0,0 +1,533 @@
+/*
+ * FM-Index Implementation (BWT + backward search)
+ *
+ * Low-memory alternative to the suffix tree for fixed-reference,
+ * many-query workloads. The index stores the Burrows-Wheeler transform
+ * of text+'$' with sampled occurrence checkpoints and a sampled suffix
+ * array, so total index size is a small constant times n bytes instead
+ * of hundreds of bytes per character for suffix tree nodes.
+ *
+ * Construction: O(n log² n) - prefix-doubling suffix array, then BWT
+ * Search: O(m) backward search for counting, plus O(SA_SAMPLE_RATE)
+ *         LF-mapping steps per reported position
+ * Space: ~1.5n bytes (BWT + occ checkpoints + SA samples)
+ */
+
+#include "pattern_matching.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define FM_TERMINATOR '$'
+#define OCC_RATE 128        // Occurrence checkpoint every OCC_RATE BWT positions
+#define SA_SAMPLE_RATE 32   // Keep SA entries whose value is a multiple of this
+
+struct FMIndex {
+    int n;                  // Text length including terminator
+    int alphabet_size;      // Number of distinct bytes in text+'$'
+    int char_rank[256];     // Byte -> compact alphabet code (-1 if absent)
+    unsigned char code_char[256];  // Compact code -> byte
+    char *bwt;              // Burrows-Wheeler transform, n bytes
+    int *c_table;           // c_table[c] = rows starting with symbol < c (size alphabet_size+1)
+    int *occ_cp;            // Checkpoint occ counts, (n/OCC_RATE + 1) * alphabet_size
+    unsigned long long *sampled_bits;  // Bit r set if row r has a sampled SA value
+    int *bits_rank;         // Set bits in words [0, w), one entry per 64-bit word
+    int *sa_samples;        // Sampled SA values, indexed by rank of set bit
+    int sample_count;
+    void *map_base;         // Non-NULL when loaded via mmap (arrays point into it)
+    size_t map_size;
+};
+
+/* ---- Suffix array construction (prefix doubling) ---- */
+
+// qsort comparator state: rank array, current comparison offset, length
+static const int *sa_cmp_rank;
+static int sa_cmp_k;
+static int sa_cmp_n;
+
+static int suffix_compare(const void *a, const void *b) {
+    int i = *(const int *)a;
+    int j = *(const int *)b;
+    if (sa_cmp_rank[i] != sa_cmp_rank[j])
+        return sa_cmp_rank[i] - sa_cmp_rank[j];
+    int ri = (i + sa_cmp_k < sa_cmp_n) ? sa_cmp_rank[i + sa_cmp_k] : -1;
+    int rj = (j + sa_cmp_k < sa_cmp_n) ? sa_cmp_rank[j + sa_cmp_k] : -1;
+    return ri - rj;
+}
+
+// Sorts suffixes by their first 2k characters, doubling k each round.
+// Returns: 0 on success, -1 on allocation failure
+static int build_suffix_array(const char *text, int n, int *sa) {
+    int *rank = (int *)malloc(n * sizeof(int));
+    int *new_rank = (int *)malloc(n * sizeof(int));
+    if (!rank || !new_rank) {
+        free(rank);
+        free(new_rank);
+        return -1;
+    }
+
+    for (int i = 0; i < n; i++) {
+        sa[i] = i;
+        rank[i] = (unsigned char)text[i];
+    }
+
+    for (int k = 1; ; k *= 2) {
+        sa_cmp_rank = rank;
+        sa_cmp_k = k;
+        sa_cmp_n = n;
+        qsort(sa, n, sizeof(int), suffix_compare);
+
+        // Re-rank: equal 2k-prefixes share a rank
+        new_rank[sa[0]] = 0;
+        for (int i = 1; i < n; i++) {
+            new_rank[sa[i]] = new_rank[sa[i - 1]] +
+                              (suffix_compare(&sa[i - 1], &sa[i]) < 0 ? 1 : 0);
+        }
+        for (int i = 0; i < n; i++) {
+            rank[i] = new_rank[i];
+        }
+
+        if (rank[sa[n - 1]] == n - 1) break;  // All suffixes distinct
+    }
+
+    free(rank);
+    free(new_rank);
+    return 0;
+}
+
+/* ---- Rank / occ helpers ---- */
+
+// Occurrences of symbol code in bwt[0..i] (inclusive); i may be -1
+static int fm_occ(const FMIndex *index, int code, int i) {
+    if (i < 0) return 0;
+
+    int cp = (i + 1) / OCC_RATE;
+    int count = index->occ_cp[cp * index->alphabet_size + code];
+
+    // Scan the at most OCC_RATE-1 bytes past the checkpoint
+    unsigned char symbol = index->code_char[code];
+    for (int j = cp * OCC_RATE; j <= i; j++) {
+        if ((unsigned char)index->bwt[j] == symbol) count++;
+    }
+    return count;
+}
+
+// Number of set bits in sampled_bits[0..r-1]
+static int fm_bits_rank(const FMIndex *index, int r) {
+    int w = r / 64;
+    int count = index->bits_rank[w];
+    int rem = r % 64;
+    if (rem > 0) {
+        count += __builtin_popcountll(index->sampled_bits[w] &
+                                      ((1ULL << rem) - 1));
+    }
+    return count;
+}
+
+// LF-mapping: row of the cyclic rotation one character to the left
+static int fm_lf(const FMIndex *index, int row) {
+    int code = index->char_rank[(unsigned char)index->bwt[row]];
+    return index->c_table[code] + fm_occ(index, code, row) - 1;
+}
+
+// Recovers SA[row] by walking LF until a sampled row is reached
+static int fm_locate(const FMIndex *index, int row) {
+    int steps = 0;
+    while (!(index->sampled_bits[row / 64] & (1ULL << (row % 64)))) {
+        row = fm_lf(index, row);
+        steps++;
+    }
+    return index->sa_samples[fm_bits_rank(index, row)] + steps;
+}
+
+// Safe integer comparison for qsort (avoids overflow)
+static int compare_position(const void *a, const void *b) {
+    int ia = *(const int *)a;
+    int ib = *(const int *)b;
+    if (ia < ib) return -1;
+    if (ia > ib) return 1;
+    return 0;
+}
+
+/* ---- Public API ---- */
+
+// Appends '$' terminator (as in the suffix tree) and builds the index
+FMIndex* create_fm_index(const char *text) {
+    if (!text) return NULL;
+
+    int original_len = strlen(text);
+    int n = original_len + 1;
+
+    FMIndex *index = (FMIndex *)calloc(1, sizeof(FMIndex));
+    if (!index) return NULL;
+    index->n = n;
+
+    char *padded = (char *)malloc(n);
+    int *sa = (int *)malloc(n * sizeof(int));
+    if (!padded || !sa) {
+        free(padded);
+        free(sa);
+        free(index);
+        return NULL;
+    }
+    memcpy(padded, text, original_len);
+    padded[original_len] = FM_TERMINATOR;
+
+    if (build_suffix_array(padded, n, sa) < 0) {
+        free(padded);
+        free(sa);
+        free(index);
+        return NULL;
+    }
+
+    // Compact alphabet: map each present byte to its sorted rank
+    int byte_count[256] = {0};
+    for (int i = 0; i < n; i++) {
+        byte_count[(unsigned char)padded[i]]++;
+    }
+    for (int c = 0; c < 256; c++) index->char_rank[c] = -1;
+    int sigma = 0;
+    for (int c = 0; c < 256; c++) {
+        if (byte_count[c] > 0) {
+            index->code_char[sigma] = (unsigned char)c;
+            index->char_rank[c] = sigma++;
+        }
+    }
+    index->alphabet_size = sigma;
+
+    // C table: number of suffixes starting with a smaller symbol
+    index->c_table = (int *)calloc(sigma + 1, sizeof(int));
+    int num_cp = n / OCC_RATE + 1;
+    index->occ_cp = (int *)calloc((size_t)num_cp * sigma, sizeof(int));
+    index->bwt = (char *)malloc(n);
+    int num_words = n / 64 + 1;
+    index->sampled_bits = (unsigned long long *)calloc(num_words, sizeof(unsigned long long));
+    index->bits_rank = (int *)calloc(num_words + 1, sizeof(int));
+    index->sample_count = (n + SA_SAMPLE_RATE - 1) / SA_SAMPLE_RATE;
+    index->sa_samples = (int *)malloc(index->sample_count * sizeof(int));
+
+    if (!index->c_table || !index->occ_cp || !index->bwt ||
+        !index->sampled_bits || !index->bits_rank || !index->sa_samples) {
+        free(padded);
+        free(sa);
+        free_fm_index(index);
+        return NULL;
+    }
+
+    for (int c = 0; c < 256; c++) {
+        if (index->char_rank[c] >= 0) {
+            index->c_table[index->char_rank[c] + 1] = byte_count[c];
+        }
+    }
+    for (int i = 1; i <= sigma; i++) {
+        index->c_table[i] += index->c_table[i - 1];
+    }
+
+    // BWT, occ checkpoints, and text-position SA sampling in one pass
+    int *running_occ = (int *)calloc(sigma, sizeof(int));
+    if (!running_occ) {
+        free(padded);
+        free(sa);
+        free_fm_index(index);
+        return NULL;
+    }
+
+    int samples_seen = 0;
+    for (int i = 0; i < n; i++) {
+        if (i % OCC_RATE == 0) {
+            memcpy(&index->occ_cp[(i / OCC_RATE) * sigma], running_occ,
+                   sigma * sizeof(int));
+        }
+        char b = (sa[i] > 0) ? padded[sa[i] - 1] : padded[n - 1];
+        index->bwt[i] = b;
+        running_occ[index->char_rank[(unsigned char)b]]++;
+
+        if (sa[i] % SA_SAMPLE_RATE == 0) {
+            index->sampled_bits[i / 64] |= 1ULL << (i % 64);
+            samples_seen++;
+        }
+    }
+    free(running_occ);
+
+    // Bitvector rank checkpoints, then sampled values in row order
+    for (int w = 0; w < num_words; w++) {
+        index->bits_rank[w + 1] = index->bits_rank[w] +
+                                  __builtin_popcountll(index->sampled_bits[w]);
+    }
+    index->sample_count = samples_seen;
+    int sample_idx = 0;
+    for (int i = 0; i < n; i++) {
+        if (index->sampled_bits[i / 64] & (1ULL << (i % 64))) {
+            index->sa_samples[sample_idx++] = sa[i];
+        }
+    }
+
+    free(padded);
+    free(sa);
+    return index;
+}
+
+// Backward search: narrows the suffix-array interval one pattern
+// character at a time, right to left. Returns 0 with the interval in
+// *sp_out/*ep_out (empty when start > end), or -1 if some pattern
+// character never occurs in the text.
+static int fm_backward_range(const FMIndex *index, const char *pattern, int m,
+                             int *sp_out, int *ep_out) {
+    int sp = 0;
+    int ep = index->n - 1;
+
+    for (int i = m - 1; i >= 0 && sp <= ep; i--) {
+        int code = index->char_rank[(unsigned char)pattern[i]];
+        if (code < 0) return -1;
+        sp = index->c_table[code] + fm_occ(index, code, sp - 1);
+        ep = index->c_table[code] + fm_occ(index, code, ep) - 1;
+    }
+
+    *sp_out = sp;
+    *ep_out = ep;
+    return 0;
+}
+
+// Full search: backward search for the interval, then locate each row
+MatchResult fm_index_search(FMIndex *index, const char *pattern) {
+    MatchResult result;
+    init_match_result(&result);
+
+    if (!index || !pattern) return result;
+
+    PerfTimer timer;
+    perf_timer_start(&timer);
+
+    int m = strlen(pattern);
+    int original_len = index->n - 1;
+
+    if (m == 0 || m > original_len) {
+        perf_timer_stop(&timer, &result);
+        return result;
+    }
+
+    int sp, ep;
+    if (fm_backward_range(index, pattern, m, &sp, &ep) < 0) {
+        // Some pattern character never occurs in the text
+        perf_timer_stop(&timer, &result);
+        return result;
+    }
+
+    if (sp > ep) {
+        perf_timer_stop(&timer, &result);
+        return result;
+    }
+
+    int count = ep - sp + 1;
+    int *matches = (int *)malloc(count * sizeof(int));
+    if (!matches) {
+        perf_timer_stop(&timer, &result);
+        return result;
+    }
+
+    for (int row = sp; row <= ep; row++) {
+        matches[row - sp] = fm_locate(index, row);
+    }
+
+    // Rows are suffix-array order, not text order
+    if (count > 1) {
+        qsort(matches, count, sizeof(int), compare_position);
+    }
+
+    perf_timer_stop(&timer, &result);
+
+    result.positions = matches;
+    result.count = count;
+    result.memory_used = (size_t)index->n +
+                         (size_t)(index->n / OCC_RATE + 1) * index->alphabet_size * sizeof(int) +
+                         (size_t)index->sample_count * sizeof(int) +
+                         (size_t)count * sizeof(int);
+
+    return result;
+}
+
+// Count-only query: backward search alone - no fm_locate() walks, no
+// position array. O(m) regardless of how often the pattern occurs.
+MatchResult fm_index_count(FMIndex *index, const char *pattern) {
+    MatchResult result;
+    init_match_result(&result);
+
+    if (!index || !pattern) return result;
+
+    PerfTimer timer;
+    perf_timer_start(&timer);
+
+    int m = strlen(pattern);
+    if (m > 0 && m <= index->n - 1) {
+        int sp, ep;
+        if (fm_backward_range(index, pattern, m, &sp, &ep) == 0 && sp <= ep) {
+            result.count = ep - sp + 1;
+        }
+    }
+
+    perf_timer_stop(&timer, &result);
+    return result;
+}
+
+void free_fm_index(FMIndex *index) {
+    if (!index) return;
+
+    if (index->map_base) {
+        // Loaded from disk: all arrays live inside one mapping
+        munmap(index->map_base, index->map_size);
+    } else {
+        free(index->bwt);
+        free(index->c_table);
+        free(index->occ_cp);
+        free(index->sampled_bits);
+        free(index->bits_rank);
+        free(index->sa_samples);
+    }
+    free(index);
+}
+
+/* ---- On-disk index format ----
+ *
+ * Flat, relocatable layout: a fixed header followed by the index arrays
+ * in a fixed order, with no pointers in the file. Loading is a single
+ * read-only mmap plus pointer fixups into the mapping, so startup cost
+ * is milliseconds and concurrent processes share one page-cached copy.
+ *
+ * Array order keeps everything naturally aligned: the 8-byte bitvector
+ * words come first after the (8-byte-aligned) header, then the int
+ * arrays, then the byte-granular BWT last.
+ */
+
+#define FM_INDEX_MAGIC "HASHFMI1"
+
+typedef struct {
+    char magic[8];              // FM_INDEX_MAGIC
+    int n;
+    int alphabet_size;
+    int sample_count;
+    int reserved;
+    int char_rank[256];
+    unsigned char code_char[256];
+} FMIndexFileHeader;
+
+// Number of 64-bit words in the sampled-rows bitvector
+static int fm_num_words(int n) {
+    return n / 64 + 1;
+}
+
+// Number of occurrence checkpoints
+static int fm_num_checkpoints(int n) {
+    return n / OCC_RATE + 1;
+}
+
+// Writes the index to filename. Returns: 0 on success, -1 on failure
+int save_fm_index(const FMIndex *index, const char *filename) {
+    if (!index || !filename || index->map_base) {
+        // Refuse to re-save an mmap-loaded index; it is already on disk
+        if (index && index->map_base)
+            fprintf(stderr, "Error: index is already file-backed\n");
+        return -1;
+    }
+
+    FILE *file = fopen(filename, "wb");
+    if (!file) {
+        fprintf(stderr, "Error: Cannot create index file %s\n", filename);
+        return -1;
+    }
+
+    FMIndexFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, FM_INDEX_MAGIC, 8);
+    header.n = index->n;
+    header.alphabet_size = index->alphabet_size;
+    header.sample_count = index->sample_count;
+    memcpy(header.char_rank, index->char_rank, sizeof(header.char_rank));
+    memcpy(header.code_char, index->code_char, sizeof(header.code_char));
+
+    int num_words = fm_num_words(index->n);
+    size_t ok = fwrite(&header, sizeof(header), 1, file);
+    ok &= fwrite(index->sampled_bits, sizeof(unsigned long long), num_words, file) == (size_t)num_words;
+    ok &= fwrite(index->c_table, sizeof(int), index->alphabet_size + 1, file) == (size_t)(index->alphabet_size + 1);
+    ok &= fwrite(index->occ_cp, sizeof(int),
+                 (size_t)fm_num_checkpoints(index->n) * index->alphabet_size, file) ==
+                 (size_t)fm_num_checkpoints(index->n) * index->alphabet_size;
+    ok &= fwrite(index->bits_rank, sizeof(int), num_words + 1, file) == (size_t)(num_words + 1);
+    ok &= fwrite(index->sa_samples, sizeof(int), index->sample_count, file) == (size_t)index->sample_count;
+    ok &= fwrite(index->bwt, 1, index->n, file) == (size_t)index->n;
+
+    if (fclose(file) != 0 || !ok) {
+        fprintf(stderr, "Error: Failed writing index file %s\n", filename);
+        return -1;
+    }
+    return 0;
+}
+
+// Loads an index saved by save_fm_index() via a read-only mmap
+FMIndex* load_fm_index(const char *filename) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Error: Cannot open index file %s\n", filename);
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(FMIndexFileHeader)) {
+        close(fd);
+        return NULL;
+    }
+    size_t map_size = (size_t)st.st_size;
+
+    void *base = mmap(NULL, map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // Mapping survives the close
+    if (base == MAP_FAILED) {
+        fprintf(stderr, "Error: mmap failed for %s\n", filename);
+        return NULL;
+    }
+
+    const FMIndexFileHeader *header = (const FMIndexFileHeader *)base;
+    if (memcmp(header->magic, FM_INDEX_MAGIC, 8) != 0) {
+        fprintf(stderr, "Error: %s is not a valid index file\n", filename);
+        munmap(base, map_size);
+        return NULL;
+    }
+
+    FMIndex *index = (FMIndex *)calloc(1, sizeof(FMIndex));
+    if (!index) {
+        munmap(base, map_size);
+        return NULL;
+    }
+
+    index->n = header->n;
+    index->alphabet_size = header->alphabet_size;
+    index->sample_count = header->sample_count;
+    memcpy(index->char_rank, header->char_rank, sizeof(index->char_rank));
+    memcpy(index->code_char, header->code_char, sizeof(index->code_char));
+    index->map_base = base;
+    index->map_size = map_size;
+
+    // Fix up array pointers into the mapping, mirroring the save order
+    int num_words = fm_num_words(index->n);
+    char *p = (char *)base + sizeof(FMIndexFileHeader);
+    index->sampled_bits = (unsigned long long *)p;
+    p += (size_t)num_words * sizeof(unsigned long long);
+    index->c_table = (int *)p;
+    p += (size_t)(index->alphabet_size + 1) * sizeof(int);
+    index->occ_cp = (int *)p;
+    p += (size_t)fm_num_checkpoints(index->n) * index->alphabet_size * sizeof(int);
+    index->bits_rank = (int *)p;
+    p += (size_t)(num_words + 1) * sizeof(int);
+    index->sa_samples = (int *)p;
+    p += (size_t)index->sample_count * sizeof(int);
+    index->bwt = p;
+    p += index->n;
+
+    if ((size_t)(p - (char *)base) > map_size) {
+        fprintf(stderr, "Error: index file %s is truncated\n", filename);
+        munmap(base, map_size);
+        free(index);
+        return NULL;
+    }
+
+    return index;
+}
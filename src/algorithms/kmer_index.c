@@ -0,0 +1,304 @@
+/*
+ * k-mer Seed Index
+ *
+ * For fixed-reference workloads (one genome, millions of short queries)
+ * even O(n+m) per query is too slow. This index hashes every k-mer of
+ * the text into an open-addressed flat table pointing at a shared
+ * position array (CSR layout: one offset/count per distinct k-mer, all
+ * positions contiguous). seed_and_extend_search() looks up the rarest
+ * k-mer of the pattern and verifies only those candidate loci, turning
+ * per-query cost from O(n) into O(occurrences of the rarest seed).
+ *
+ * Build: O(n) - two rolling passes over the text
+ * Query: O(m + candidates * m)
+ * Space: O(n) ints + the hash table
+ *
+ * Complements the suffix tree: far cheaper to build (seconds, not
+ * minutes, and ~40x less memory), at the price of needing m >= k.
+ */
+
+#include "pattern_matching.h"
+
+#define DEFAULT_K 12
+#define EMPTY_KEY 0xFFFFFFFFFFFFFFFFULL
+
+// Open-addressed slot: k-mer code -> slice of the positions array
+typedef struct {
+    unsigned long long key;
+    int count;
+    int offset;
+} KmerSlot;
+
+struct KmerIndex {
+    const char *text;        // Not owned; must outlive the index
+    size_t text_len;
+    int k;
+
+    KmerSlot *slots;
+    size_t num_slots;        // Power of two
+    int *positions;          // All k-mer occurrence positions, grouped per k-mer
+    size_t num_positions;
+};
+
+// A=0 C=1 G=2 T=3; anything else (N, stray bytes) poisons the window
+static int kmer_base_code(char c) {
+    switch (c) {
+        case 'A': return 0;
+        case 'C': return 1;
+        case 'G': return 2;
+        case 'T': return 3;
+        default:  return -1;
+    }
+}
+
+// SplitMix64 finalizer - spreads the 2k-bit codes over the table
+static unsigned long long kmer_hash(unsigned long long key) {
+    key ^= key >> 30;
+    key *= 0xBF58476D1CE4E5B9ULL;
+    key ^= key >> 27;
+    key *= 0x94D049BB133111EBULL;
+    key ^= key >> 31;
+    return key;
+}
+
+// Linear probing; returns the slot holding key, or the empty slot where
+// it belongs. The table is sized so a free slot always exists.
+static KmerSlot* kmer_find_slot(const KmerIndex *index, unsigned long long key) {
+    size_t mask = index->num_slots - 1;
+    size_t i = (size_t)kmer_hash(key) & mask;
+
+    while (index->slots[i].key != EMPTY_KEY && index->slots[i].key != key) {
+        i = (i + 1) & mask;
+    }
+    return &index->slots[i];
+}
+
+// Calls visit(code, pos) for every valid (ACGT-only) k-mer window,
+// maintaining the rolling 2-bit code and skipping past invalid bases
+typedef void (*kmer_visit_fn)(KmerIndex *index, unsigned long long code, int pos);
+
+static void kmer_scan_text(KmerIndex *index, kmer_visit_fn visit) {
+    int k = index->k;
+    unsigned long long mask = (k < 32) ? ((1ULL << (2 * k)) - 1) : ~0ULL;
+    unsigned long long code = 0;
+    int run = 0;  // Valid bases accumulated in the current window
+
+    for (size_t i = 0; i < index->text_len; i++) {
+        int b = kmer_base_code(index->text[i]);
+        if (b < 0) {
+            run = 0;
+            code = 0;
+            continue;
+        }
+        code = ((code << 2) | (unsigned long long)b) & mask;
+        if (++run >= k) {
+            visit(index, code, (int)(i - k + 1));
+        }
+    }
+}
+
+static void kmer_count_visit(KmerIndex *index, unsigned long long code, int pos) {
+    (void)pos;
+    KmerSlot *slot = kmer_find_slot(index, code);
+    if (slot->key == EMPTY_KEY) {
+        slot->key = code;
+        slot->count = 0;
+    }
+    slot->count++;
+}
+
+static void kmer_fill_visit(KmerIndex *index, unsigned long long code, int pos) {
+    KmerSlot *slot = kmer_find_slot(index, code);
+    // offset doubles as the fill cursor during the second pass
+    index->positions[slot->offset++] = pos;
+}
+
+/**
+ * Builds the k-mer index over text. k = 0 selects the default (12);
+ * valid range is 4..31. The index keeps a pointer to text (no copy),
+ * so text must stay alive while the index is used.
+ * Returns: the index, or NULL on failure
+ */
+KmerIndex* create_kmer_index(const char *text, int k) {
+    if (!text) return NULL;
+    if (k == 0) k = DEFAULT_K;
+    if (k < 4 || k > 31) {
+        fprintf(stderr, "create_kmer_index: k must be in 4..31\n");
+        return NULL;
+    }
+
+    KmerIndex *index = (KmerIndex *)calloc(1, sizeof(KmerIndex));
+    if (!index) return NULL;
+
+    index->text = text;
+    index->text_len = strlen(text);
+    index->k = k;
+
+    if (index->text_len < (size_t)k) {
+        free(index);
+        return NULL;
+    }
+
+    // Power-of-two table with load factor <= 0.5 even if every window
+    // is a distinct k-mer
+    size_t windows = index->text_len - k + 1;
+    size_t num_slots = 16;
+    while (num_slots < windows * 2) num_slots <<= 1;
+
+    index->num_slots = num_slots;
+    // Slot table and position array scale with the text - huge-page
+    // backed so index probes stop thrashing the dTLB
+    index->slots = (KmerSlot *)large_alloc(num_slots * sizeof(KmerSlot));
+    if (!index->slots) {
+        free(index);
+        return NULL;
+    }
+    for (size_t i = 0; i < num_slots; i++) {
+        index->slots[i].key = EMPTY_KEY;
+        index->slots[i].count = 0;
+        index->slots[i].offset = 0;
+    }
+
+    // Pass 1: count occurrences per distinct k-mer
+    kmer_scan_text(index, kmer_count_visit);
+
+    // Prefix sums carve the shared positions array into per-k-mer slices
+    size_t total = 0;
+    for (size_t i = 0; i < num_slots; i++) {
+        if (index->slots[i].key != EMPTY_KEY) {
+            index->slots[i].offset = (int)total;
+            total += index->slots[i].count;
+        }
+    }
+    index->num_positions = total;
+
+    index->positions = (int *)large_alloc((total > 0 ? total : 1) * sizeof(int));
+    if (!index->positions) {
+        large_free(index->slots);
+        free(index);
+        return NULL;
+    }
+
+    // Pass 2: drop each position into its slice (offset is the cursor)
+    kmer_scan_text(index, kmer_fill_visit);
+
+    // Restore offsets to slice starts
+    for (size_t i = 0; i < num_slots; i++) {
+        if (index->slots[i].key != EMPTY_KEY) {
+            index->slots[i].offset -= index->slots[i].count;
+        }
+    }
+
+    return index;
+}
+
+// 2-bit code of pattern[at .. at+k-1], or -1 if it contains a non-ACGT base
+static long long kmer_code_at(const char *pattern, int at, int k) {
+    unsigned long long code = 0;
+    for (int i = 0; i < k; i++) {
+        int b = kmer_base_code(pattern[at + i]);
+        if (b < 0) return -1;
+        code = (code << 2) | (unsigned long long)b;
+    }
+    return (long long)code;
+}
+
+/**
+ * Seed-and-extend query: finds the rarest k-mer of the pattern in the
+ * index, then verifies the full pattern only at those candidate loci.
+ * Patterns shorter than k (or with no ACGT-only k-mer) fall back to a
+ * plain KMP scan of the indexed text.
+ */
+MatchResult seed_and_extend_search(const KmerIndex *index, const char *pattern) {
+    MatchResult result;
+    init_match_result(&result);
+
+    if (!index || !pattern) return result;
+
+    PerfTimer timer;
+    perf_timer_start(&timer);
+
+    int m = strlen(pattern);
+    int k = index->k;
+
+    // Pick the pattern k-mer with the fewest text occurrences: fewer
+    // candidates to verify, and an absent k-mer proves zero matches
+    int best_at = -1;
+    const KmerSlot *best_slot = NULL;
+
+    if (m >= k) {
+        for (int at = 0; at + k <= m; at++) {
+            long long code = kmer_code_at(pattern, at, k);
+            if (code < 0) continue;
+
+            KmerSlot *slot = kmer_find_slot(index, (unsigned long long)code);
+            int count = (slot->key == EMPTY_KEY) ? 0 : slot->count;
+
+            if (best_at < 0 || count < best_slot->count || count == 0) {
+                best_at = at;
+                best_slot = slot;
+            }
+            if (count == 0) break;  // Seed absent: no match possible
+        }
+    }
+
+    if (best_at < 0) {
+        // No usable seed (short pattern or non-ACGT throughout);
+        // the KMP scan times itself, so retire this timer first
+        perf_timer_stop(&timer, &result);
+        result = kmp_search(index->text, pattern);
+        return result;
+    }
+
+    if (best_slot->key == EMPTY_KEY || best_slot->count == 0) {
+        perf_timer_stop(&timer, &result);
+        return result;
+    }
+
+    int capacity = 100;
+    int *matches = (int *)malloc(capacity * sizeof(int));
+    if (!matches) {
+        fprintf(stderr, "Memory allocation failed\n");
+        perf_timer_stop(&timer, &result);
+        return result;
+    }
+    result.memory_used = capacity * sizeof(int);
+
+    int count = 0;
+    for (int i = 0; i < best_slot->count; i++) {
+        // Candidate locus: seed position minus the seed's offset in the pattern
+        long long locus = (long long)index->positions[best_slot->offset + i] - best_at;
+        if (locus < 0 || locus + m > (long long)index->text_len) continue;
+
+        if (memcmp(index->text + locus, pattern, m) == 0) {
+            if (count >= capacity) {
+                capacity *= 2;
+                int *temp = (int *)realloc(matches, capacity * sizeof(int));
+                if (!temp) {
+                    free(matches);
+                    fprintf(stderr, "Memory reallocation failed\n");
+                    perf_timer_stop(&timer, &result);
+                    return result;
+                }
+                matches = temp;
+                result.memory_used = capacity * sizeof(int);
+            }
+            matches[count++] = (int)locus;
+        }
+    }
+
+    perf_timer_stop(&timer, &result);
+
+    result.positions = matches;
+    result.count = count;
+
+    return result;
+}
+
+void free_kmer_index(KmerIndex *index) {
+    if (!index) return;
+
+    large_free(index->slots);
+    large_free(index->positions);
+    free(index);
+}
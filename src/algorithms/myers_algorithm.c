@@ -0,0 +1,154 @@
+/*
+ * Myers Bit-Parallel Approximate Matching
+ * Edit-distance search in O(n * ceil(m/64)) for the whole text
+ * Space Complexity: O(ceil(m/64) * sigma)
+ *
+ * Encodes one column of the edit-distance DP matrix as plus/minus
+ * delta bit-vectors (Myers 1999), advancing all m cells per text
+ * character with a handful of word operations - no per-window DP and
+ * no per-window allocation, unlike levenshtein_search(). Patterns
+ * longer than 64 characters use Hyyro's block formulation with
+ * horizontal carries between words.
+ */
+
+#include "pattern_matching.h"
+
+#define WORD_BITS 64
+
+/**
+ * Finds every text position where some substring ending there matches
+ * the pattern within max_distance edits. One entry is reported per
+ * qualifying end position; ApproximateMatch.position holds the
+ * estimated match start (end - m + 1, clamped to 0) and .distance the
+ * edit distance of the best match ending there.
+ */
+ApproximateMatchResult myers_search(const char *text, const char *pattern, int max_distance) {
+    ApproximateMatchResult result;
+    result.matches = NULL;
+    result.count = 0;
+    result.time_taken = 0.0;
+    result.memory_used = 0;
+
+    if (!text || !pattern) {
+        return result;
+    }
+
+    clock_t start = clock();
+
+    int n = strlen(text);
+    int m = strlen(pattern);
+
+    if (m == 0) {
+        clock_t end = clock();
+        result.time_taken = ((double)(end - start)) / CLOCKS_PER_SEC * 1000.0;
+        return result;
+    }
+
+    int blocks = (m + WORD_BITS - 1) / WORD_BITS;
+
+    // Peq[block][c]: bit j set if pattern[block*64 + j] == c
+    unsigned long long *peq = (unsigned long long *)calloc((size_t)blocks * 256,
+                                                           sizeof(unsigned long long));
+    unsigned long long *pv = (unsigned long long *)malloc(blocks * sizeof(unsigned long long));
+    unsigned long long *mv = (unsigned long long *)calloc(blocks, sizeof(unsigned long long));
+    if (!peq || !pv || !mv) {
+        free(peq);
+        free(pv);
+        free(mv);
+        fprintf(stderr, "Memory allocation failed\n");
+        return result;
+    }
+
+    for (int i = 0; i < m; i++) {
+        peq[(size_t)(i / WORD_BITS) * 256 + (unsigned char)pattern[i]] |=
+            1ULL << (i % WORD_BITS);
+    }
+    for (int b = 0; b < blocks; b++) {
+        pv[b] = ~0ULL;
+    }
+
+    // Per-block top bit: bit 63 for full blocks, bit (m-1)%64 for the last
+    unsigned long long last_top = 1ULL << ((m - 1) % WORD_BITS);
+
+    result.memory_used = (size_t)blocks * 256 * sizeof(unsigned long long) +
+                         2 * (size_t)blocks * sizeof(unsigned long long);
+
+    int capacity = 100;
+    ApproximateMatch *matches = (ApproximateMatch *)malloc(capacity * sizeof(ApproximateMatch));
+    if (!matches) {
+        free(peq);
+        free(pv);
+        free(mv);
+        fprintf(stderr, "Memory allocation failed\n");
+        return result;
+    }
+    result.memory_used += capacity * sizeof(ApproximateMatch);
+
+    int count = 0;
+    int score = m;  // Edit distance of the best match ending at the current column
+
+    for (int i = 0; i < n; i++) {
+        unsigned char c = (unsigned char)text[i];
+        int hin = 0;  // Horizontal delta carried into the block (top row is all 0s)
+
+        for (int b = 0; b < blocks; b++) {
+            unsigned long long top = (b == blocks - 1)
+                                     ? last_top : (1ULL << (WORD_BITS - 1));
+            unsigned long long eq = peq[(size_t)b * 256 + c];
+            unsigned long long xv = eq | mv[b];
+            if (hin < 0) eq |= 1ULL;
+
+            unsigned long long xh = (((eq & pv[b]) + pv[b]) ^ pv[b]) | eq;
+            unsigned long long ph = mv[b] | ~(xh | pv[b]);
+            unsigned long long mh = pv[b] & xh;
+
+            int hout = 0;
+            if (ph & top) hout = 1;
+            else if (mh & top) hout = -1;
+
+            ph = (ph << 1) | ((hin > 0) ? 1ULL : 0ULL);
+            mh = (mh << 1) | ((hin < 0) ? 1ULL : 0ULL);
+
+            pv[b] = mh | ~(xv | ph);
+            mv[b] = ph & xv;
+
+            hin = hout;
+        }
+
+        score += hin;  // Carry out of the last block moves the bottom cell
+
+        if (score <= max_distance) {
+            if (count >= capacity) {
+                capacity *= 2;
+                ApproximateMatch *temp = (ApproximateMatch *)realloc(matches,
+                                         capacity * sizeof(ApproximateMatch));
+                if (!temp) {
+                    free(matches);
+                    free(peq);
+                    free(pv);
+                    free(mv);
+                    fprintf(stderr, "Memory reallocation failed\n");
+                    return result;
+                }
+                matches = temp;
+                result.memory_used += capacity * sizeof(ApproximateMatch) / 2;
+            }
+            int match_start = i - m + 1;
+            matches[count].position = (match_start > 0) ? match_start : 0;
+            matches[count].distance = score;
+            count++;
+        }
+    }
+
+    clock_t end = clock();
+
+    free(peq);
+    free(pv);
+    free(mv);
+
+    result.matches = matches;
+    result.count = count;
+    result.time_taken = ((double)(end - start)) / CLOCKS_PER_SEC * 1000.0;
+
+    return result;
+}
@@ -11,23 +11,20 @@
  */
 MatchResult naive_search(const char *text, const char *pattern) {
     MatchResult result;
-    result.positions = NULL;
-    result.count = 0;
-    result.time_taken = 0.0;
-    result.memory_used = 0;
+    init_match_result(&result);
     
     if (!text || !pattern) {
         return result;
     }
     
-    clock_t start = clock();
+    PerfTimer timer;
+    perf_timer_start(&timer);
     
     int n = strlen(text);
     int m = strlen(pattern);
     
     if (m == 0 || m > n) {
-        clock_t end = clock();
-        result.time_taken = ((double)(end - start)) / CLOCKS_PER_SEC * 1000.0;
+        perf_timer_stop(&timer, &result);
         return result;
     }
     
@@ -36,6 +33,7 @@ MatchResult naive_search(const char *text, const char *pattern) {
     int *matches = (int *)malloc(capacity * sizeof(int));
     if (!matches) {
         fprintf(stderr, "Memory allocation failed\n");
+        perf_timer_stop(&timer, &result);
         return result;
     }
     
@@ -61,6 +59,7 @@ MatchResult naive_search(const char *text, const char *pattern) {
                 if (!temp) {
                     free(matches);
                     fprintf(stderr, "Memory reallocation failed\n");
+                    perf_timer_stop(&timer, &result);
                     return result;
                 }
                 matches = temp;
@@ -70,11 +69,10 @@ MatchResult naive_search(const char *text, const char *pattern) {
         }
     }
     
-    clock_t end = clock();
+    perf_timer_stop(&timer, &result);
     
     result.positions = matches;
     result.count = count;
-    result.time_taken = ((double)(end - start)) / CLOCKS_PER_SEC * 1000.0;
     
     return result;
 }
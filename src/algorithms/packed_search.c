@@ -0,0 +1,204 @@
+/*
+ * Packed-Aware Search Kernels
+ *
+ * Search directly over the 2-bit PackedDNA representation. One 64-bit
+ * compare covers 32 bases, so the naive scan touches a quarter of the
+ * memory and does 1/32 of the comparisons of the byte version; KMP
+ * gains the bandwidth win from the smaller working set.
+ */
+
+#include "pattern_matching.h"
+
+// 2-bit code of the base at position pos
+static unsigned long long packed_base(const PackedDNA *text, size_t pos) {
+    return (text->words[pos / 32] >> (2 * (pos % 32))) & 3ULL;
+}
+
+// 64-bit window of up to 32 bases starting at an arbitrary base offset,
+// stitched from the two straddled words
+static unsigned long long packed_window(const PackedDNA *text, size_t pos) {
+    size_t w = pos / 32;
+    int shift = 2 * (int)(pos % 32);
+    unsigned long long window = text->words[w] >> shift;
+    if (shift > 0 && w + 1 < text->num_words) {
+        window |= text->words[w + 1] << (64 - shift);
+    }
+    return window;
+}
+
+// Grows the match array when full. Returns: 0 on success, -1 on failure
+static int append_match(int **matches, int *count, int *capacity, int pos) {
+    if (*count >= *capacity) {
+        *capacity *= 2;
+        int *temp = (int *)realloc(*matches, *capacity * sizeof(int));
+        if (!temp) return -1;
+        *matches = temp;
+    }
+    (*matches)[(*count)++] = pos;
+    return 0;
+}
+
+/**
+ * Word-at-a-time naive scan over packed text: each alignment compares 32
+ * bases per 64-bit word, with the final partial word masked to 2*rem bits.
+ */
+MatchResult packed_naive_search(const PackedDNA *text, const char *pattern) {
+    MatchResult result;
+    init_match_result(&result);
+
+    if (!text || !pattern) {
+        return result;
+    }
+
+    PerfTimer timer;
+    perf_timer_start(&timer);
+
+    size_t n = text->length;
+    size_t m = strlen(pattern);
+
+    if (m == 0 || m > n) {
+        perf_timer_stop(&timer, &result);
+        return result;
+    }
+
+    // Pack the pattern once; rejects non-ACGT patterns
+    PackedDNA *packed_pattern = pack_dna_sequence(pattern, m);
+    if (!packed_pattern) {
+        return result;
+    }
+
+    size_t full_words = m / 32;
+    int rem_bases = (int)(m % 32);
+    unsigned long long rem_mask = rem_bases ? ((1ULL << (2 * rem_bases)) - 1) : 0;
+
+    int capacity = 100;
+    int *matches = (int *)malloc(capacity * sizeof(int));
+    if (!matches) {
+        free_packed_dna(packed_pattern);
+        fprintf(stderr, "Memory allocation failed\n");
+        perf_timer_stop(&timer, &result);
+        return result;
+    }
+    result.memory_used = capacity * sizeof(int) + packed_pattern->num_words * sizeof(unsigned long long);
+
+    int count = 0;
+    for (size_t i = 0; i + m <= n; i++) {
+        size_t w;
+        for (w = 0; w < full_words; w++) {
+            if (packed_window(text, i + w * 32) != packed_pattern->words[w]) break;
+        }
+        if (w < full_words) continue;
+
+        if (rem_bases &&
+            ((packed_window(text, i + full_words * 32) ^ packed_pattern->words[full_words]) & rem_mask))
+            continue;
+
+        if (append_match(&matches, &count, &capacity, (int)i) < 0) {
+            free(matches);
+            free_packed_dna(packed_pattern);
+            fprintf(stderr, "Memory reallocation failed\n");
+            perf_timer_stop(&timer, &result);
+            return result;
+        }
+    }
+
+    perf_timer_stop(&timer, &result);
+
+    free_packed_dna(packed_pattern);
+
+    result.positions = matches;
+    result.count = count;
+
+    return result;
+}
+
+/**
+ * KMP over packed text: the LPS-driven scan is unchanged, but text
+ * accesses go through the 2-bit accessor so the working set is a quarter
+ * of the byte representation.
+ */
+MatchResult packed_kmp_search(const PackedDNA *text, const char *pattern) {
+    MatchResult result;
+    init_match_result(&result);
+
+    if (!text || !pattern) {
+        return result;
+    }
+
+    PerfTimer timer;
+    perf_timer_start(&timer);
+
+    size_t n = text->length;
+    int m = strlen(pattern);
+
+    if (m == 0 || (size_t)m > n) {
+        perf_timer_stop(&timer, &result);
+        return result;
+    }
+
+    // Pre-encode the pattern as 2-bit codes; rejects non-ACGT patterns
+    PackedDNA *packed_pattern = pack_dna_sequence(pattern, m);
+    if (!packed_pattern) {
+        return result;
+    }
+
+    int *lps = (int *)malloc(m * sizeof(int));
+    if (!lps) {
+        free_packed_dna(packed_pattern);
+        fprintf(stderr, "Memory allocation failed for LPS array\n");
+        perf_timer_stop(&timer, &result);
+        return result;
+    }
+    compute_lps_array(pattern, m, lps);
+    result.memory_used += m * sizeof(int);
+
+    int capacity = 100;
+    int *matches = (int *)malloc(capacity * sizeof(int));
+    if (!matches) {
+        free(lps);
+        free_packed_dna(packed_pattern);
+        fprintf(stderr, "Memory allocation failed for matches\n");
+        perf_timer_stop(&timer, &result);
+        return result;
+    }
+    result.memory_used += capacity * sizeof(int);
+
+    int count = 0;
+    size_t i = 0;
+    int j = 0;
+
+    while (i < n) {
+        if (packed_base(packed_pattern, j) == packed_base(text, i)) {
+            i++;
+            j++;
+        }
+
+        if (j == m) {
+            if (append_match(&matches, &count, &capacity, (int)(i - j)) < 0) {
+                free(lps);
+                free(matches);
+                free_packed_dna(packed_pattern);
+                fprintf(stderr, "Memory reallocation failed\n");
+                perf_timer_stop(&timer, &result);
+                return result;
+            }
+            j = lps[j - 1];
+        } else if (i < n && packed_base(packed_pattern, j) != packed_base(text, i)) {
+            if (j != 0) {
+                j = lps[j - 1];
+            } else {
+                i++;
+            }
+        }
+    }
+
+    perf_timer_stop(&timer, &result);
+
+    free(lps);
+    free_packed_dna(packed_pattern);
+
+    result.positions = matches;
+    result.count = count;
+
+    return result;
+}
@@ -0,0 +1,331 @@
+/*
+ * Parallel Chunked Search Driver
+ *
+ * Splits the text into one chunk per thread, extends every chunk but the
+ * last by (m-1) bytes of overlap so no match spanning a boundary is
+ * lost, runs any of the existing single-threaded matchers per chunk,
+ * and merges the per-chunk position lists back in text order.
+ * Time Complexity: O(n/p + m) per thread for the linear matchers
+ * Space Complexity: O(n/p) per thread (private chunk copy)
+ */
+
+#define _GNU_SOURCE
+#include "pattern_matching.h"
+#include <pthread.h>
+#include <unistd.h>
+
+// Dispatches to the single-threaded implementation of an algorithm
+static MatchResult run_algorithm(SearchAlgorithm algo, const char *text, const char *pattern) {
+    switch (algo) {
+        case SEARCH_ALGO_NAIVE:       return naive_search(text, pattern);
+        case SEARCH_ALGO_KMP:         return kmp_search(text, pattern);
+        case SEARCH_ALGO_BOYER_MOORE: return boyer_moore_search(text, pattern);
+        case SEARCH_ALGO_RABIN_KARP:  return rabin_karp_search(text, pattern);
+        case SEARCH_ALGO_Z:           return z_algorithm_search(text, pattern);
+        case SEARCH_ALGO_SHIFT_OR:    return shift_or_search(text, pattern);
+    }
+
+    MatchResult empty;
+    init_match_result(&empty);
+    return empty;
+}
+
+typedef struct {
+    SearchAlgorithm algo;
+    const char *text;
+    const char *pattern;
+    size_t chunk_start;   // First text position this chunk owns
+    size_t chunk_len;     // Positions owned (matches must start inside)
+    size_t search_len;    // chunk_len + overlap, clamped to text end
+    MatchResult result;   // Positions relative to chunk_start after filtering
+    int failed;
+} ChunkJob;
+
+// Thread body: copy the chunk into a NUL-terminated private buffer, run
+// the matcher, and drop matches that start inside the overlap tail
+// (those belong to the next chunk and would otherwise be reported twice)
+static void* search_chunk(void *arg) {
+    ChunkJob *job = (ChunkJob *)arg;
+
+    char *buffer = (char *)malloc(job->search_len + 1);
+    if (!buffer) {
+        job->failed = 1;
+        return NULL;
+    }
+    memcpy(buffer, job->text + job->chunk_start, job->search_len);
+    buffer[job->search_len] = '\0';
+
+    MatchResult local = run_algorithm(job->algo, buffer, job->pattern);
+    free(buffer);
+
+    // Keep only matches this chunk owns
+    int kept = 0;
+    for (int i = 0; i < local.count; i++) {
+        if ((size_t)local.positions[i] < job->chunk_len) {
+            local.positions[kept++] = local.positions[i];
+        }
+    }
+    local.count = kept;
+
+    job->result = local;
+    return NULL;
+}
+
+/**
+ * Runs any exact matcher across nthreads chunks in parallel and merges
+ * the per-chunk results into one position list sorted in text order.
+ * nthreads <= 0 uses the number of online CPUs.
+ */
+MatchResult parallel_search(SearchAlgorithm algo, const char *text, size_t text_len,
+                            const char *pattern, int nthreads) {
+    MatchResult result;
+    init_match_result(&result);
+
+    if (!text || !pattern) return result;
+
+    size_t m = strlen(pattern);
+    if (m == 0 || m > text_len) return result;
+
+    if (nthreads <= 0) {
+        long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = (ncpu > 0) ? (int)ncpu : 1;
+    }
+    // No point spawning threads that own less than one pattern length
+    if ((size_t)nthreads > text_len / m + 1) {
+        nthreads = (int)(text_len / m) + 1;
+    }
+
+    // Wall-clock timing: clock() sums CPU time across threads and would
+    // hide the speedup entirely
+    struct timespec wall_start, wall_end;
+    clock_gettime(CLOCK_MONOTONIC, &wall_start);
+
+    if (nthreads == 1) {
+        result = run_algorithm(algo, text, pattern);
+        clock_gettime(CLOCK_MONOTONIC, &wall_end);
+        result.wall_time_ns = (wall_end.tv_sec - wall_start.tv_sec) * 1000000000LL +
+                              (wall_end.tv_nsec - wall_start.tv_nsec);
+        result.time_taken = result.wall_time_ns / 1e6;
+        return result;
+    }
+
+    ChunkJob *jobs = (ChunkJob *)calloc(nthreads, sizeof(ChunkJob));
+    pthread_t *threads = (pthread_t *)malloc(nthreads * sizeof(pthread_t));
+    if (!jobs || !threads) {
+        free(jobs);
+        free(threads);
+        return result;
+    }
+
+    size_t base_len = text_len / nthreads;
+    for (int t = 0; t < nthreads; t++) {
+        jobs[t].algo = algo;
+        jobs[t].text = text;
+        jobs[t].pattern = pattern;
+        jobs[t].chunk_start = (size_t)t * base_len;
+        jobs[t].chunk_len = (t == nthreads - 1) ? text_len - jobs[t].chunk_start
+                                                : base_len;
+        // Overlap so matches straddling the boundary are seen by this chunk
+        jobs[t].search_len = jobs[t].chunk_len + m - 1;
+        if (jobs[t].chunk_start + jobs[t].search_len > text_len) {
+            jobs[t].search_len = text_len - jobs[t].chunk_start;
+        }
+        jobs[t].failed = 0;
+    }
+
+    char *thread_ok = (char *)calloc(nthreads, 1);
+    for (int t = 0; t < nthreads; t++) {
+        if (thread_ok && pthread_create(&threads[t], NULL, search_chunk, &jobs[t]) == 0) {
+            thread_ok[t] = 1;
+        } else {
+            // Could not spawn a thread: run this chunk inline
+            search_chunk(&jobs[t]);
+        }
+    }
+    for (int t = 0; t < nthreads; t++) {
+        if (thread_ok && thread_ok[t]) {
+            pthread_join(threads[t], NULL);
+        }
+    }
+    free(thread_ok);
+
+    // A chunk that could not allocate its buffer produced no matches;
+    // merging the rest would silently return a partial result
+    for (int t = 0; t < nthreads; t++) {
+        if (jobs[t].failed) {
+            fprintf(stderr, "Memory allocation failed\n");
+            for (int i = 0; i < nthreads; i++) {
+                free_match_result(&jobs[i].result);
+            }
+            free(jobs);
+            free(threads);
+            return result;
+        }
+    }
+
+    // Merge: chunks are in text order and each list is already sorted
+    int total = 0;
+    size_t memory_used = 0;
+    for (int t = 0; t < nthreads; t++) {
+        total += jobs[t].result.count;
+        memory_used += jobs[t].result.memory_used;
+    }
+
+    int *merged = NULL;
+    if (total > 0) {
+        merged = (int *)malloc(total * sizeof(int));
+        if (merged) {
+            int out = 0;
+            for (int t = 0; t < nthreads; t++) {
+                for (int i = 0; i < jobs[t].result.count; i++) {
+                    merged[out++] = jobs[t].result.positions[i] + (int)jobs[t].chunk_start;
+                }
+            }
+        } else {
+            total = 0;
+        }
+    }
+
+    for (int t = 0; t < nthreads; t++) {
+        free_match_result(&jobs[t].result);
+    }
+    free(jobs);
+    free(threads);
+
+    clock_gettime(CLOCK_MONOTONIC, &wall_end);
+
+    result.positions = merged;
+    result.count = total;
+    result.wall_time_ns = (wall_end.tv_sec - wall_start.tv_sec) * 1000000000LL +
+                          (wall_end.tv_nsec - wall_start.tv_nsec);
+    result.time_taken = result.wall_time_ns / 1e6;
+    result.memory_used = memory_used + (size_t)total * sizeof(int);
+
+    return result;
+}
+
+/* ---- Per-record fan-out over multi-record FASTA collections ---- */
+
+// Work pool: threads pull the next unsearched record until none remain,
+// so a few large contigs do not leave most of the pool idle
+typedef struct {
+    SearchAlgorithm algo;
+    const FastaCollection *collection;
+    const char *pattern;
+    int next_record;
+    pthread_mutex_t lock;
+    MatchResult *per_record;   // One result slot per record, in order
+} RecordPool;
+
+static void* search_records(void *arg) {
+    RecordPool *pool = (RecordPool *)arg;
+
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        int idx = pool->next_record++;
+        pthread_mutex_unlock(&pool->lock);
+
+        if (idx >= pool->collection->count) break;
+
+        pool->per_record[idx] = run_algorithm(pool->algo,
+                                              pool->collection->records[idx]->sequence,
+                                              pool->pattern);
+    }
+    return NULL;
+}
+
+/**
+ * Searches every record of a multi-record FASTA collection, fanning
+ * records out across a thread pool. Matches are reported as
+ * (record_id, offset-within-record) pairs, ordered by record then
+ * position - no match can span a record boundary.
+ * nthreads <= 0 uses the number of online CPUs.
+ */
+MultiRecordResult multi_record_search(SearchAlgorithm algo, const FastaCollection *collection,
+                                      const char *pattern, int nthreads) {
+    MultiRecordResult result;
+    result.matches = NULL;
+    result.count = 0;
+    result.time_taken = 0.0;
+    result.memory_used = 0;
+
+    if (!collection || collection->count == 0 || !pattern) return result;
+
+    if (nthreads <= 0) {
+        long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = (ncpu > 0) ? (int)ncpu : 1;
+    }
+    if (nthreads > collection->count) {
+        nthreads = collection->count;
+    }
+
+    struct timespec wall_start, wall_end;
+    clock_gettime(CLOCK_MONOTONIC, &wall_start);
+
+    RecordPool pool;
+    pool.algo = algo;
+    pool.collection = collection;
+    pool.pattern = pattern;
+    pool.next_record = 0;
+    pool.per_record = (MatchResult *)calloc(collection->count, sizeof(MatchResult));
+    if (!pool.per_record) return result;
+    pthread_mutex_init(&pool.lock, NULL);
+
+    pthread_t *threads = (pthread_t *)malloc(nthreads * sizeof(pthread_t));
+    char *thread_ok = (char *)calloc(nthreads, 1);
+    if (threads && thread_ok && nthreads > 1) {
+        for (int t = 0; t < nthreads; t++) {
+            thread_ok[t] = (pthread_create(&threads[t], NULL, search_records, &pool) == 0);
+        }
+        // If nothing could be spawned, the main thread drains the pool
+        search_records(&pool);
+        for (int t = 0; t < nthreads; t++) {
+            if (thread_ok[t]) pthread_join(threads[t], NULL);
+        }
+    } else {
+        search_records(&pool);
+    }
+    free(threads);
+    free(thread_ok);
+    pthread_mutex_destroy(&pool.lock);
+
+    // Assemble (record, offset) pairs in record order
+    int total = 0;
+    size_t memory_used = 0;
+    for (int r = 0; r < collection->count; r++) {
+        total += pool.per_record[r].count;
+        memory_used += pool.per_record[r].memory_used;
+    }
+
+    RecordMatch *matches = NULL;
+    if (total > 0) {
+        matches = (RecordMatch *)malloc(total * sizeof(RecordMatch));
+        if (matches) {
+            int out = 0;
+            for (int r = 0; r < collection->count; r++) {
+                for (int i = 0; i < pool.per_record[r].count; i++) {
+                    matches[out].record_id = r;
+                    matches[out].position = pool.per_record[r].positions[i];
+                    out++;
+                }
+            }
+        } else {
+            total = 0;
+        }
+    }
+
+    for (int r = 0; r < collection->count; r++) {
+        free_match_result(&pool.per_record[r]);
+    }
+    free(pool.per_record);
+
+    clock_gettime(CLOCK_MONOTONIC, &wall_end);
+
+    result.matches = matches;
+    result.count = total;
+    result.time_taken = (wall_end.tv_sec - wall_start.tv_sec) * 1000.0 +
+                        (wall_end.tv_nsec - wall_start.tv_nsec) / 1e6;
+    result.memory_used = memory_used + (size_t)total * sizeof(RecordMatch);
+
+    return result;
+}
@@ -0,0 +1,138 @@
+/*
+ * Count-Only and Sampled Query Modes
+ *
+ * Abundance screening only needs "how many times does this motif
+ * occur", yet a regular search materializes the full positions array -
+ * for AAA-like patterns on a chromosome that is hundreds of MB thrown
+ * away immediately. These drivers ride the callback delivery path
+ * (search_cb), so the count-only mode stores nothing at all and the
+ * sampling mode keeps only every Nth match - enough for preview UIs
+ * like print_sequence_with_highlights() without the full list.
+ *
+ * Z-Algorithm has no callback core (compile_pattern() cannot express
+ * its concatenated preprocessing), so it runs the normal search and
+ * reduces the result afterwards - same output, no storage saving.
+ */
+
+#include "pattern_matching.h"
+
+/**
+ * Counts occurrences without storing a single position: positions stays
+ * NULL and count holds the total. Uses the null-callback counting path,
+ * so match-dense queries allocate nothing per match.
+ */
+MatchResult count_only_search(SearchAlgorithm algo, const char *text, size_t text_len,
+                              const char *pattern) {
+    MatchResult result;
+    init_match_result(&result);
+
+    if (!text || !pattern) return result;
+
+    PerfTimer timer;
+    perf_timer_start(&timer);
+
+    long long count;
+    if (algo == SEARCH_ALGO_Z) {
+        MatchResult full = z_algorithm_search(text, pattern);
+        count = full.count;
+        free_match_result(&full);
+    } else {
+        count = search_cb(algo, text, text_len, pattern, NULL, NULL);
+    }
+
+    perf_timer_stop(&timer, &result);
+
+    if (count < 0) {
+        fprintf(stderr, "count_only_search: search failed\n");
+        return result;
+    }
+
+    result.count = (int)count;
+    return result;
+}
+
+// Callback state: keep match 0, N, 2N, ... and drop the rest
+typedef struct {
+    int every_nth;
+    long long seen;
+    int *positions;
+    int count;
+    int capacity;
+    int failed;
+} SampleState;
+
+static int sample_match(long long position, void *user) {
+    SampleState *state = (SampleState *)user;
+
+    if (state->seen++ % state->every_nth != 0) return 0;
+
+    if (state->count >= state->capacity) {
+        state->capacity *= 2;
+        int *temp = (int *)realloc(state->positions, state->capacity * sizeof(int));
+        if (!temp) {
+            state->failed = 1;
+            return -1;
+        }
+        state->positions = temp;
+    }
+    state->positions[state->count++] = (int)position;
+    return 0;
+}
+
+/**
+ * Keeps every Nth match (the 1st, N+1th, ...) and drops the rest, so a
+ * preview never holds more than total/N positions. count reports the
+ * number of positions kept, not the total - use count_only_search()
+ * for totals. every_nth <= 1 keeps every match.
+ */
+MatchResult sampled_search(SearchAlgorithm algo, const char *text, size_t text_len,
+                           const char *pattern, int every_nth) {
+    MatchResult result;
+    init_match_result(&result);
+
+    if (!text || !pattern) return result;
+    if (every_nth < 1) every_nth = 1;
+
+    if (algo == SEARCH_ALGO_Z) {
+        // No callback core: reduce the full result in place
+        result = z_algorithm_search(text, pattern);
+        int kept = 0;
+        for (int i = 0; i < result.count; i += every_nth) {
+            result.positions[kept++] = result.positions[i];
+        }
+        result.count = kept;
+        return result;
+    }
+
+    PerfTimer timer;
+    perf_timer_start(&timer);
+
+    SampleState state;
+    state.every_nth = every_nth;
+    state.seen = 0;
+    state.count = 0;
+    state.capacity = 100;
+    state.failed = 0;
+    state.positions = (int *)malloc(state.capacity * sizeof(int));
+    if (!state.positions) {
+        fprintf(stderr, "Memory allocation failed\n");
+        perf_timer_stop(&timer, &result);
+        return result;
+    }
+
+    long long delivered = search_cb(algo, text, text_len, pattern, sample_match, &state);
+
+    perf_timer_stop(&timer, &result);
+
+    if (delivered < 0 || state.failed) {
+        free(state.positions);
+        if (state.failed) fprintf(stderr, "Memory reallocation failed\n");
+        else fprintf(stderr, "sampled_search: search failed\n");
+        return result;
+    }
+
+    result.positions = state.positions;
+    result.count = state.count;
+    result.memory_used = state.capacity * sizeof(int);
+    return result;
+}
@@ -1,109 +1,254 @@
-/*
- * Rabin-Karp Algorithm Implementation
- * Uses rolling hash for efficient pattern matching
- * Time Complexity: O(n+m) average case, O(nm) worst case
- * Space Complexity: O(1)
- */
-
-#include "pattern_matching.h"
-
-#define PRIME 101
-#define BASE 256
-
-MatchResult rabin_karp_search(const char *text, const char *pattern) {
-    MatchResult result;
-    result.positions = NULL;
-    result.count = 0;
-    result.time_taken = 0.0;
-    result.memory_used = 0;
-    
-    if (!text || !pattern) {
-        return result;
-    }
-    
-    clock_t start = clock();
-    
-    int n = strlen(text);
-    int m = strlen(pattern);
-    
-    if (m == 0 || m > n) {
-        clock_t end = clock();
-        result.time_taken = ((double)(end - start)) / CLOCKS_PER_SEC * 1000.0;
-        return result;
-    }
-    
-    // Allocate space for matches
-    int capacity = 100;
-    int *matches = (int *)malloc(capacity * sizeof(int));
-    if (!matches) {
-        fprintf(stderr, "Memory allocation failed\n");
-        return result;
-    }
-    
-    result.memory_used = capacity * sizeof(int);
-    
-    unsigned long long pattern_hash = 0;
-    unsigned long long text_hash = 0;
-    unsigned long long h = 1;
-    
-    // Calculate h = BASE^(m-1) % PRIME
-    // This is the multiplier for the most significant digit in the rolling hash
-    for (int i = 0; i < m - 1; i++) {
-        h = (h * BASE) % PRIME;
-    }
-    
-    // Calculate initial hash values for pattern and first window of text
-    for (int i = 0; i < m; i++) {
-        pattern_hash = (BASE * pattern_hash + (unsigned char)pattern[i]) % PRIME;
-        text_hash = (BASE * text_hash + (unsigned char)text[i]) % PRIME;
-    }
-    
-    int count = 0;
-    
-    // Slide pattern over text one by one
-    for (int i = 0; i <= n - m; i++) {
-        // If hash values match, check characters one by one to avoid collisions
-        if (pattern_hash == text_hash) {
-            int match = 1;
-            for (int j = 0; j < m; j++) {
-                if (text[i + j] != pattern[j]) {
-                    match = 0;
-                    break;
-                }
-            }
-            
-            if (match) {
-                if (count >= capacity) {
-                    capacity *= 2;
-                    int *temp = (int *)realloc(matches, capacity * sizeof(int));
-                    if (!temp) {
-                        free(matches);
-                        fprintf(stderr, "Memory reallocation failed\n");
-                        return result;
-                    }
-                    matches = temp;
-                    result.memory_used = capacity * sizeof(int);
-                }
-                matches[count++] = i;
-            }
-        }
-        
-        // Calculate rolling hash for next window
-        if (i < n - m) {
-            // Remove leading character: subtract (text[i] * h)
-            // Add trailing character: add text[i+m]
-            unsigned long long old_char = ((unsigned char)text[i] * h) % PRIME;
-            text_hash = (text_hash + PRIME - old_char) % PRIME;
-            text_hash = (text_hash * BASE) % PRIME;
-            text_hash = (text_hash + (unsigned char)text[i + m]) % PRIME;
-        }
-    }
-    
-    clock_t end = clock();
-    
-    result.positions = matches;
-    result.count = count;
-    result.time_taken = ((double)(end - start)) / CLOCKS_PER_SEC * 1000.0;
-    
-    return result;
-}
+/*
+ * Rabin-Karp Algorithm Implementation
+ * Uses a 64-bit rolling hash modulo the Mersenne prime 2^61 - 1
+ * Time Complexity: O(n+m) expected; verification only on fingerprint hits
+ * Space Complexity: O(1)
+ *
+ * A small modulus (the old PRIME 101) collides constantly on 4-letter
+ * DNA text, sending nearly every window into the O(m) verification path.
+ * With a 61-bit fingerprint the collision probability is ~n/2^61, so the
+ * character comparison effectively runs only on true matches. 2^61 - 1
+ * being Mersenne lets the modular reduction be two shifts and an add
+ * instead of a divide.
+ */
+
+#include "pattern_matching.h"
+
+#define RK_BASE 256ULL
+
+// Lanes for the batch variant: independent rolling-hash dependency
+// chains advanced per loop iteration to hide multiply latency
+#define RK_LANES 4
+
+// (a * b) mod (2^61 - 1)
+unsigned long long rk_mulmod(unsigned long long a, unsigned long long b) {
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 t = (unsigned __int128)a * b;
+    unsigned long long r = (unsigned long long)(t & RK_MERSENNE_P) +
+                           (unsigned long long)(t >> 61);
+#else
+    // Portable fallback: 32-bit limb products folded with 2^61 = 1 (mod p)
+    unsigned long long a0 = a & 0xFFFFFFFFULL, a1 = a >> 32;
+    unsigned long long b0 = b & 0xFFFFFFFFULL, b1 = b >> 32;
+    unsigned long long lo = a0 * b0;
+    unsigned long long mid = a1 * b0 + a0 * b1;       // < 2^62 (a1, b1 < 2^29)
+    unsigned long long hi = a1 * b1;                  // < 2^58
+    unsigned long long r = (lo & RK_MERSENNE_P) + (lo >> 61);
+    r += ((mid & ((1ULL << 29) - 1)) << 32) + (mid >> 29);  // mid * 2^32
+    r += hi << 3;                                           // hi * 2^64 = hi * 8
+#endif
+    while (r >= RK_MERSENNE_P) r -= RK_MERSENNE_P;
+    return r;
+}
+
+// BASE^exponent mod (2^61 - 1) - the leading-character multiplier
+unsigned long long rk_pow_base(int exponent) {
+    unsigned long long result = 1;
+    for (int i = 0; i < exponent; i++) {
+        result = rk_mulmod(result, RK_BASE);
+    }
+    return result;
+}
+
+// Rolling step: drop the leading character, shift, append the new one
+static unsigned long long rk_roll(unsigned long long hash, unsigned char out_c,
+                                  unsigned char in_c, unsigned long long h) {
+    unsigned long long drop = rk_mulmod(out_c, h);
+    hash = (hash + RK_MERSENNE_P - drop) % RK_MERSENNE_P;
+    hash = rk_mulmod(hash, RK_BASE);
+    hash = (hash + in_c) % RK_MERSENNE_P;
+    return hash;
+}
+
+static unsigned long long rk_hash_window(const char *s, int m) {
+    unsigned long long hash = 0;
+    for (int i = 0; i < m; i++) {
+        hash = rk_mulmod(hash, RK_BASE);
+        hash = (hash + (unsigned char)s[i]) % RK_MERSENNE_P;
+    }
+    return hash;
+}
+
+// Safe integer comparison for qsort (avoids overflow)
+static int compare_int(const void *a, const void *b) {
+    int ia = *(const int*)a;
+    int ib = *(const int*)b;
+    if (ia < ib) return -1;
+    if (ia > ib) return 1;
+    return 0;
+}
+
+static int append_match(int **matches, int *count, int *capacity, size_t *mem, int pos) {
+    if (*count >= *capacity) {
+        *capacity *= 2;
+        int *temp = (int *)realloc(*matches, *capacity * sizeof(int));
+        if (!temp) {
+            fprintf(stderr, "Memory reallocation failed\n");
+            return -1;
+        }
+        *matches = temp;
+        *mem = *capacity * sizeof(int);
+    }
+    (*matches)[(*count)++] = pos;
+    return 0;
+}
+
+MatchResult rabin_karp_search(const char *text, const char *pattern) {
+    MatchResult result;
+    init_match_result(&result);
+
+    if (!text || !pattern) {
+        return result;
+    }
+
+    PerfTimer timer;
+    perf_timer_start(&timer);
+
+    int n = strlen(text);
+    int m = strlen(pattern);
+
+    if (m == 0 || m > n) {
+        perf_timer_stop(&timer, &result);
+        return result;
+    }
+
+    // Allocate space for matches
+    int capacity = 100;
+    int *matches = (int *)malloc(capacity * sizeof(int));
+    if (!matches) {
+        fprintf(stderr, "Memory allocation failed\n");
+        perf_timer_stop(&timer, &result);
+        return result;
+    }
+
+    result.memory_used = capacity * sizeof(int);
+
+    // h = BASE^(m-1): the multiplier of the character leaving the window
+    unsigned long long h = rk_pow_base(m - 1);
+    unsigned long long pattern_hash = rk_hash_window(pattern, m);
+    unsigned long long text_hash = rk_hash_window(text, m);
+
+    int count = 0;
+
+    // Slide pattern over text one by one
+    for (int i = 0; i <= n - m; i++) {
+        // Fingerprints collide with probability ~2^-61, so this branch
+        // fires essentially only on true matches; verify to be exact
+        if (pattern_hash == text_hash && memcmp(text + i, pattern, m) == 0) {
+            if (append_match(&matches, &count, &capacity, &result.memory_used, i) < 0) {
+                free(matches);
+                perf_timer_stop(&timer, &result);
+                return result;
+            }
+        }
+
+        if (i < n - m) {
+            text_hash = rk_roll(text_hash, (unsigned char)text[i],
+                                (unsigned char)text[i + m], h);
+        }
+    }
+
+    perf_timer_stop(&timer, &result);
+
+    result.positions = matches;
+    result.count = count;
+
+    return result;
+}
+
+// Batch variant: splits the window range into RK_LANES stripes and rolls
+// one hash per stripe every loop iteration. The four multiply chains are
+// independent, so the CPU overlaps their latencies instead of waiting on
+// one serial chain. Positions are qsorted once at the end.
+MatchResult rabin_karp_batch_search(const char *text, const char *pattern) {
+    MatchResult result;
+    init_match_result(&result);
+
+    if (!text || !pattern) {
+        return result;
+    }
+
+    PerfTimer timer;
+    perf_timer_start(&timer);
+
+    int n = strlen(text);
+    int m = strlen(pattern);
+
+    if (m == 0 || m > n) {
+        perf_timer_stop(&timer, &result);
+        return result;
+    }
+
+    int capacity = 100;
+    int *matches = (int *)malloc(capacity * sizeof(int));
+    if (!matches) {
+        fprintf(stderr, "Memory allocation failed\n");
+        perf_timer_stop(&timer, &result);
+        return result;
+    }
+    result.memory_used = capacity * sizeof(int);
+
+    unsigned long long h = rk_pow_base(m - 1);
+    unsigned long long pattern_hash = rk_hash_window(pattern, m);
+
+    int total = n - m + 1;          // Number of windows
+    int lane_len = total / RK_LANES;
+    int count = 0;
+
+    unsigned long long lane_hash[RK_LANES];
+    int lane_start[RK_LANES];
+    for (int k = 0; k < RK_LANES; k++) {
+        lane_start[k] = k * lane_len;
+        if (lane_len > 0) {
+            lane_hash[k] = rk_hash_window(text + lane_start[k], m);
+        }
+    }
+
+    for (int j = 0; j < lane_len; j++) {
+        for (int k = 0; k < RK_LANES; k++) {
+            int i = lane_start[k] + j;
+            if (pattern_hash == lane_hash[k] && memcmp(text + i, pattern, m) == 0) {
+                if (append_match(&matches, &count, &capacity, &result.memory_used, i) < 0) {
+                    free(matches);
+                    perf_timer_stop(&timer, &result);
+                    return result;
+                }
+            }
+            if (j + 1 < lane_len || k == RK_LANES - 1) {
+                lane_hash[k] = rk_roll(lane_hash[k], (unsigned char)text[i],
+                                       (unsigned char)text[i + m], h);
+            }
+        }
+    }
+
+    // Remainder windows (total not divisible by RK_LANES) continue on the
+    // last lane's rolling state
+    unsigned long long tail_hash = (lane_len > 0)
+                                   ? lane_hash[RK_LANES - 1]
+                                   : rk_hash_window(text, m);
+    for (int i = RK_LANES * lane_len; i < total; i++) {
+        if (pattern_hash == tail_hash && memcmp(text + i, pattern, m) == 0) {
+            if (append_match(&matches, &count, &capacity, &result.memory_used, i) < 0) {
+                free(matches);
+                perf_timer_stop(&timer, &result);
+                return result;
+            }
+        }
+        if (i + 1 < total) {
+            tail_hash = rk_roll(tail_hash, (unsigned char)text[i],
+                                (unsigned char)text[i + m], h);
+        }
+    }
+
+    // Lanes interleave in time, so restore text order
+    if (count > 1) {
+        qsort(matches, count, sizeof(int), compare_int);
+    }
+
+    perf_timer_stop(&timer, &result);
+
+    result.positions = matches;
+    result.count = count;
+
+    return result;
+}
@@ -1,99 +1,197 @@
-/*
- * Shift-Or (Bitap) Algorithm Implementation
- * Time Complexity: O(n)
- * Space Complexity: O(σ) where σ is alphabet size
- * Works for patterns up to word size (typically 64 bits)
- */
-
-#include "pattern_matching.h"
-
-#define ALPHABET_SIZE 256
-
-/**
- * Performs Exact Shift-Or (Bitap) pattern matching.
- * Optimized for patterns <= 64 characters using 64-bit integers.
- */
-MatchResult shift_or_search(const char *text, const char *pattern) {
-    MatchResult result;
-    result.positions = NULL;
-    result.count = 0;
-    result.time_taken = 0.0;
-    result.memory_used = 0;
-    
-    if (!text || !pattern) {
-        return result;
-    }
-    
-    clock_t start = clock();
-    
-    int n = strlen(text);
-    int m = strlen(pattern);
-    
-    if (m == 0 || m > 64) { // Limitation: pattern length <= 64
-        clock_t end = clock();
-        result.time_taken = ((double)(end - start)) / CLOCKS_PER_SEC * 1000.0;
-        if (m > 64) {
-            fprintf(stderr, "Shift-Or: Pattern too long (max 64 characters)\n");
-        }
-        return result;
-    }
-    
-    // Preprocessing: create pattern bitmask
-    // For each character in alphabet, create a mask where the i-th bit is 0 
-    // if the character appears at position i in the pattern, and 1 otherwise.
-    unsigned long long pattern_mask[ALPHABET_SIZE];
-    for (int i = 0; i < ALPHABET_SIZE; i++) {
-        pattern_mask[i] = ~0ULL;
-    }
-    
-    for (int i = 0; i < m; i++) {
-        pattern_mask[(unsigned char)pattern[i]] &= ~(1ULL << i);
-    }
-    
-    result.memory_used = ALPHABET_SIZE * sizeof(unsigned long long);
-    
-    int capacity = 100;
-    int *matches = (int *)malloc(capacity * sizeof(int));
-    if (!matches) {
-        fprintf(stderr, "Memory allocation failed\n");
-        return result;
-    }
-    
-    result.memory_used += capacity * sizeof(int);
-    
-    int count = 0;
-    // State bitmask: 0 bit at position i means prefix of length i+1 matches
-    unsigned long long state = ~0ULL;
-    unsigned long long match_mask = 1ULL << (m - 1);
-    
-    for (int i = 0; i < n; i++) {
-        // Update state: shift left (introduce 0 at pos 0) and OR with char mask
-        // A bit remains 0 only if it was 0 in previous state (shifted) AND 
-        // the current character matches the pattern at that position.
-        state = (state << 1) | pattern_mask[(unsigned char)text[i]];
-        
-        // If the (m-1)-th bit is 0, it means we have matched the entire pattern
-        if ((state & match_mask) == 0) {
-            if (count >= capacity) {
-                capacity *= 2;
-                int *temp = (int *)realloc(matches, capacity * sizeof(int));
-                if (!temp) {
-                    free(matches);
-                    fprintf(stderr, "Memory reallocation failed\n");
-                    return result;
-                }
-                matches = temp;
-                result.memory_used += capacity * sizeof(int) / 2;
-            }
-            matches[count++] = i - m + 1;
-        }
-    }
-    
-    clock_t end = clock();
-    
-    result.positions = matches;
-    result.count = count;
-    result.time_taken = ((double)(end - start)) / CLOCKS_PER_SEC * 1000.0;
-    
-    return result;
-}
+/*
+ * Shift-Or (Bitap) Algorithm Implementation
+ * Time Complexity: O(n * ceil(m/64))
+ * Space Complexity: O(σ * ceil(m/64)) where σ is alphabet size
+ * Single-word fast path for m <= 64; blocked multi-word state with
+ * carry propagation for longer patterns (100-300 bp probes)
+ */
+
+#include "pattern_matching.h"
+
+#define ALPHABET_SIZE 256
+#define WORD_BITS 64
+
+// Blocked bitap for patterns longer than one word: the state spans
+// ceil(m/64) words, shifted left one bit per text character with the
+// top bit of each word carried into the next. The inner loop stays
+// branch-free per word; only the match test looks at the last word.
+static MatchResult shift_or_search_blocked(const char *text, int n,
+                                           const char *pattern, int m) {
+    MatchResult result;
+    init_match_result(&result);
+
+    PerfTimer timer;
+    perf_timer_start(&timer);
+
+    int blocks = (m + WORD_BITS - 1) / WORD_BITS;
+
+    // pattern_mask[b * 256 + c]: bit r is 0 if pattern[b*64 + r] == c
+    unsigned long long *pattern_mask = (unsigned long long *)malloc(
+        (size_t)blocks * ALPHABET_SIZE * sizeof(unsigned long long));
+    unsigned long long *state = (unsigned long long *)malloc(
+        blocks * sizeof(unsigned long long));
+    if (!pattern_mask || !state) {
+        free(pattern_mask);
+        free(state);
+        fprintf(stderr, "Memory allocation failed\n");
+        perf_timer_stop(&timer, &result);
+        return result;
+    }
+
+    for (size_t i = 0; i < (size_t)blocks * ALPHABET_SIZE; i++) {
+        pattern_mask[i] = ~0ULL;
+    }
+    for (int i = 0; i < m; i++) {
+        pattern_mask[(size_t)(i / WORD_BITS) * ALPHABET_SIZE +
+                     (unsigned char)pattern[i]] &= ~(1ULL << (i % WORD_BITS));
+    }
+    for (int b = 0; b < blocks; b++) {
+        state[b] = ~0ULL;
+    }
+
+    result.memory_used = (size_t)blocks * (ALPHABET_SIZE + 1) * sizeof(unsigned long long);
+
+    int capacity = 100;
+    int *matches = (int *)malloc(capacity * sizeof(int));
+    if (!matches) {
+        free(pattern_mask);
+        free(state);
+        fprintf(stderr, "Memory allocation failed\n");
+        perf_timer_stop(&timer, &result);
+        return result;
+    }
+    result.memory_used += capacity * sizeof(int);
+
+    unsigned long long match_mask = 1ULL << ((m - 1) % WORD_BITS);
+    int count = 0;
+
+    for (int i = 0; i < n; i++) {
+        unsigned char c = (unsigned char)text[i];
+        unsigned long long carry = 0;  // Shift-in for bit 0 is 0 (new prefix start)
+        for (int b = 0; b < blocks; b++) {
+            unsigned long long top = state[b] >> (WORD_BITS - 1);
+            state[b] = ((state[b] << 1) | carry) |
+                       pattern_mask[(size_t)b * ALPHABET_SIZE + c];
+            carry = top;
+        }
+
+        if ((state[blocks - 1] & match_mask) == 0) {
+            if (count >= capacity) {
+                capacity *= 2;
+                int *temp = (int *)realloc(matches, capacity * sizeof(int));
+                if (!temp) {
+                    free(matches);
+                    free(pattern_mask);
+                    free(state);
+                    fprintf(stderr, "Memory reallocation failed\n");
+                    perf_timer_stop(&timer, &result);
+                    return result;
+                }
+                matches = temp;
+                result.memory_used += capacity * sizeof(int) / 2;
+            }
+            matches[count++] = i - m + 1;
+        }
+    }
+
+    perf_timer_stop(&timer, &result);
+
+    free(pattern_mask);
+    free(state);
+
+    result.positions = matches;
+    result.count = count;
+
+    return result;
+}
+
+/**
+ * Performs Exact Shift-Or (Bitap) pattern matching.
+ * Single 64-bit state word for patterns <= 64 characters; longer
+ * patterns use the blocked multi-word variant above.
+ */
+MatchResult shift_or_search(const char *text, const char *pattern) {
+    MatchResult result;
+    init_match_result(&result);
+
+    if (!text || !pattern) {
+        return result;
+    }
+
+    PerfTimer timer;
+    perf_timer_start(&timer);
+
+    int n = strlen(text);
+    int m = strlen(pattern);
+
+    if (m == 0) {
+        perf_timer_stop(&timer, &result);
+        return result;
+    }
+
+    if (m > 64) {
+        // The blocked variant times itself, so retire this timer first
+        perf_timer_stop(&timer, &result);
+        return shift_or_search_blocked(text, n, pattern, m);
+    }
+
+    // Preprocessing: create pattern bitmask
+    // For each character in alphabet, create a mask where the i-th bit is 0 
+    // if the character appears at position i in the pattern, and 1 otherwise.
+    unsigned long long pattern_mask[ALPHABET_SIZE];
+    for (int i = 0; i < ALPHABET_SIZE; i++) {
+        pattern_mask[i] = ~0ULL;
+    }
+    
+    for (int i = 0; i < m; i++) {
+        pattern_mask[(unsigned char)pattern[i]] &= ~(1ULL << i);
+    }
+    
+    result.memory_used = ALPHABET_SIZE * sizeof(unsigned long long);
+    
+    int capacity = 100;
+    int *matches = (int *)malloc(capacity * sizeof(int));
+    if (!matches) {
+        fprintf(stderr, "Memory allocation failed\n");
+        perf_timer_stop(&timer, &result);
+        return result;
+    }
+    
+    result.memory_used += capacity * sizeof(int);
+    
+    int count = 0;
+    // State bitmask: 0 bit at position i means prefix of length i+1 matches
+    unsigned long long state = ~0ULL;
+    unsigned long long match_mask = 1ULL << (m - 1);
+    
+    for (int i = 0; i < n; i++) {
+        // Update state: shift left (introduce 0 at pos 0) and OR with char mask
+        // A bit remains 0 only if it was 0 in previous state (shifted) AND 
+        // the current character matches the pattern at that position.
+        state = (state << 1) | pattern_mask[(unsigned char)text[i]];
+        
+        // If the (m-1)-th bit is 0, it means we have matched the entire pattern
+        if ((state & match_mask) == 0) {
+            if (count >= capacity) {
+                capacity *= 2;
+                int *temp = (int *)realloc(matches, capacity * sizeof(int));
+                if (!temp) {
+                    free(matches);
+                    fprintf(stderr, "Memory reallocation failed\n");
+                    perf_timer_stop(&timer, &result);
+                    return result;
+                }
+                matches = temp;
+                result.memory_used += capacity * sizeof(int) / 2;
+            }
+            matches[count++] = i - m + 1;
+        }
+    }
+    
+    perf_timer_stop(&timer, &result);
+    
+    result.positions = matches;
+    result.count = count;
+    
+    return result;
+}
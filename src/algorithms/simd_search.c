@@ -0,0 +1,202 @@
+/*
+ * SIMD Rare-Byte Prefilter Search
+ *
+ * DNA text has a 4-5 symbol alphabet, so byte-at-a-time inner loops
+ * waste almost all of their work on no-match positions. This scanner
+ * picks the pattern character that is rarest in the text (estimated
+ * from a prefix sample), scans the text for that single byte 16/32
+ * bytes per instruction, and only then verifies full candidates with
+ * memcmp. Time Complexity: O(n / w + c * m) where w is the vector
+ * width and c the candidate count.
+ *
+ * The AVX2 kernel is compiled via a target attribute and selected at
+ * runtime with __builtin_cpu_supports, so the binary still runs on
+ * SSE2-only machines; non-x86 builds use a memchr-based scalar path.
+ */
+
+#include "pattern_matching.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define SIMD_X86 1
+#endif
+
+#define RARITY_SAMPLE_SIZE 65536
+
+// Counts candidate byte frequencies in a text prefix and returns the
+// offset of the rarest pattern character (scanning for the rarest byte
+// minimizes candidate verifications)
+static int pick_rarest_offset(const char *text, int n, const char *pattern, int m) {
+    int sample = (n < RARITY_SAMPLE_SIZE) ? n : RARITY_SAMPLE_SIZE;
+    int freq[256] = {0};
+    for (int i = 0; i < sample; i++) {
+        freq[(unsigned char)text[i]]++;
+    }
+
+    int best_offset = 0;
+    int best_freq = freq[(unsigned char)pattern[0]];
+    for (int i = 1; i < m; i++) {
+        int f = freq[(unsigned char)pattern[i]];
+        if (f < best_freq) {
+            best_freq = f;
+            best_offset = i;
+        }
+    }
+    return best_offset;
+}
+
+// Verifies a candidate alignment and appends it to the match list.
+// Returns: 0 on success, -1 on allocation failure
+static int verify_candidate(const char *text, int n, const char *pattern, int m,
+                            int pos, int **matches, int *count, int *capacity) {
+    if (pos < 0 || pos > n - m) return 0;
+    if (memcmp(text + pos, pattern, m) != 0) return 0;
+
+    if (*count >= *capacity) {
+        *capacity *= 2;
+        int *temp = (int *)realloc(*matches, *capacity * sizeof(int));
+        if (!temp) return -1;
+        *matches = temp;
+    }
+    (*matches)[(*count)++] = pos;
+    return 0;
+}
+
+#ifdef SIMD_X86
+
+// AVX2 kernel: compare 32 text bytes per iteration against the rare byte
+__attribute__((target("avx2")))
+static int scan_avx2(const char *text, int n, const char *pattern, int m,
+                     int offset, int **matches, int *count, int *capacity) {
+    __m256i rare = _mm256_set1_epi8(pattern[offset]);
+    int i = 0;
+
+    for (; i + 32 <= n; i += 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i *)(text + i));
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, rare));
+        while (mask) {
+            int bit = __builtin_ctz(mask);
+            mask &= mask - 1;
+            if (verify_candidate(text, n, pattern, m, i + bit - offset,
+                                 matches, count, capacity) < 0)
+                return -1;
+        }
+    }
+    for (; i < n; i++) {
+        if (text[i] == pattern[offset]) {
+            if (verify_candidate(text, n, pattern, m, i - offset,
+                                 matches, count, capacity) < 0)
+                return -1;
+        }
+    }
+    return 0;
+}
+
+// SSE2 kernel: 16 bytes per iteration, baseline on every x86-64 CPU
+static int scan_sse2(const char *text, int n, const char *pattern, int m,
+                     int offset, int **matches, int *count, int *capacity) {
+    __m128i rare = _mm_set1_epi8(pattern[offset]);
+    int i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i *)(text + i));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(block, rare));
+        while (mask) {
+            int bit = __builtin_ctz(mask);
+            mask &= mask - 1;
+            if (verify_candidate(text, n, pattern, m, i + bit - offset,
+                                 matches, count, capacity) < 0)
+                return -1;
+        }
+    }
+    for (; i < n; i++) {
+        if (text[i] == pattern[offset]) {
+            if (verify_candidate(text, n, pattern, m, i - offset,
+                                 matches, count, capacity) < 0)
+                return -1;
+        }
+    }
+    return 0;
+}
+
+#else  // !SIMD_X86
+
+// Scalar fallback: memchr is vectorized inside libc on most platforms
+static int scan_scalar(const char *text, int n, const char *pattern, int m,
+                       int offset, int **matches, int *count, int *capacity) {
+    const char *p = text;
+    const char *end = text + n;
+
+    while (p < end) {
+        const char *hit = (const char *)memchr(p, pattern[offset], end - p);
+        if (!hit) break;
+        if (verify_candidate(text, n, pattern, m, (int)(hit - text) - offset,
+                             matches, count, capacity) < 0)
+            return -1;
+        p = hit + 1;
+    }
+    return 0;
+}
+
+#endif  // SIMD_X86
+
+/**
+ * Performs rare-byte prefilter matching: vector scan for the pattern's
+ * rarest character, then candidate verification. Kernel (AVX2 / SSE2 /
+ * scalar) is selected at runtime.
+ */
+MatchResult simd_search(const char *text, const char *pattern) {
+    MatchResult result;
+    init_match_result(&result);
+
+    if (!text || !pattern) {
+        return result;
+    }
+
+    PerfTimer timer;
+    perf_timer_start(&timer);
+
+    int n = strlen(text);
+    int m = strlen(pattern);
+
+    if (m == 0 || m > n) {
+        perf_timer_stop(&timer, &result);
+        return result;
+    }
+
+    int offset = pick_rarest_offset(text, n, pattern, m);
+
+    int capacity = 100;
+    int *matches = (int *)malloc(capacity * sizeof(int));
+    if (!matches) {
+        fprintf(stderr, "Memory allocation failed\n");
+        perf_timer_stop(&timer, &result);
+        return result;
+    }
+
+    int count = 0;
+    int rc;
+#ifdef SIMD_X86
+    if (__builtin_cpu_supports("avx2")) {
+        rc = scan_avx2(text, n, pattern, m, offset, &matches, &count, &capacity);
+    } else {
+        rc = scan_sse2(text, n, pattern, m, offset, &matches, &count, &capacity);
+    }
+#else
+    rc = scan_scalar(text, n, pattern, m, offset, &matches, &count, &capacity);
+#endif
+    if (rc < 0) {
+        free(matches);
+        fprintf(stderr, "Memory reallocation failed\n");
+        perf_timer_stop(&timer, &result);
+        return result;
+    }
+
+    perf_timer_stop(&timer, &result);
+
+    result.positions = matches;
+    result.count = count;
+    result.memory_used = capacity * sizeof(int);
+
+    return result;
+}
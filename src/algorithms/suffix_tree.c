@@ -1,299 +1,624 @@
-/*
- * Suffix Tree Implementation - Explicit Construction
- * 
- * A compressed trie of all suffixes. '$' terminator ensures uniqueness.
- * Construction: O(n²) - inserts all n suffixes with '$' terminator
- * Search: O(m + k) - tree walk + leaf collection
- * Space: O(n²) worst case
- */
-
-#include "pattern_matching.h"
-
-#define ALPHABET_SIZE 256
-#define TERMINATOR '$'
-
-// Edges are labeled with substrings via [start, end] indices into text
-typedef struct SuffixTreeNode {
-    struct SuffixTreeNode *children[ALPHABET_SIZE];
-    int start;           // Start index in text for edge label
-    int end;             // End index in text for edge label (inclusive)
-    int suffix_index;    // For leaf nodes: starting position of suffix (-1 for internal)
-} SuffixTreeNode;
-
-static SuffixTreeNode* create_node(int start, int end) {
-    SuffixTreeNode *node = (SuffixTreeNode*)malloc(sizeof(SuffixTreeNode));
-    if (!node) return NULL;
-    
-    for (int i = 0; i < ALPHABET_SIZE; i++)
-        node->children[i] = NULL;
-    
-    node->start = start;
-    node->end = end;
-    node->suffix_index = -1;
-    
-    return node;
-}
-
-// Inserts suffix by walking tree and splitting edges when needed
-// Returns: 0 on success, -1 on allocation failure
-static int insert_suffix(SuffixTree *tree, int suffix_start) {
-    SuffixTreeNode *current = tree->root;
-    int text_pos = suffix_start;
-    int text_len = tree->size;
-    
-    while (text_pos < text_len) {
-        unsigned char c = (unsigned char)tree->text[text_pos];
-        
-        // Case 1: No edge for this character - create new leaf
-        if (!current->children[c]) {
-            SuffixTreeNode *leaf = create_node(text_pos, text_len - 1);
-            if (!leaf) return -1;
-            leaf->suffix_index = suffix_start;
-            current->children[c] = leaf;
-            return 0;
-        }
-        
-        SuffixTreeNode *child = current->children[c];
-        int edge_start = child->start;
-        int edge_end = child->end;
-        int edge_len = edge_end - edge_start + 1;
-        
-        // Match characters along edge until mismatch
-        int matched = 0;
-        while (matched < edge_len && 
-               text_pos + matched < text_len && 
-               tree->text[edge_start + matched] == tree->text[text_pos + matched]) {
-            matched++;
-        }
-        
-        // If matched entire edge, continue walking from child
-        if (matched == edge_len) {
-            current = child;
-            text_pos += matched;
-            continue;
-        }
-        
-        // Mismatch in middle - split edge and create internal node
-        SuffixTreeNode *split = create_node(edge_start, edge_start + matched - 1);
-        if (!split) return -1;
-        split->suffix_index = -1;
-        
-        // Attach old child and new leaf to split node
-        unsigned char old_char = (unsigned char)tree->text[edge_start + matched];
-        child->start = edge_start + matched;
-        split->children[old_char] = child;
-        
-        unsigned char new_char = (unsigned char)tree->text[text_pos + matched];
-        SuffixTreeNode *new_leaf = create_node(text_pos + matched, text_len - 1);
-        if (!new_leaf) {
-            free(split);
-            return -1;
-        }
-        new_leaf->suffix_index = suffix_start;
-        split->children[new_char] = new_leaf;
-        
-        current->children[c] = split;
-        return 0;
-    }
-    
-    current->suffix_index = suffix_start;
-    return 0;
-}
-
-// Appends '$' terminator to ensure all suffixes end at unique leaf nodes
-SuffixTree* create_suffix_tree(const char *text) {
-    if (!text) return NULL;
-    
-    int original_len = strlen(text);
-    
-    SuffixTree *tree = (SuffixTree*)malloc(sizeof(SuffixTree));
-    if (!tree) return NULL;
-    
-    tree->text = (char*)malloc(original_len + 2);
-    if (!tree->text) {
-        free(tree);
-        return NULL;
-    }
-    
-    strcpy(tree->text, text);
-    tree->text[original_len] = TERMINATOR;
-    tree->text[original_len + 1] = '\0';
-    tree->size = original_len + 1;
-    
-    // Root has no incoming edge: start=-1, end=-1
-    tree->root = create_node(-1, -1);
-    if (!tree->root) {
-        free(tree->text);
-        free(tree);
-        return NULL;
-    }
-    
-    // Build tree by inserting each suffix (O(n²) construction)
-    for (int i = 0; i < tree->size; i++) {
-        if (insert_suffix(tree, i) < 0) {
-            free_suffix_tree(tree);
-            return NULL;
-        }
-    }
-    
-    return tree;
-}
-
-typedef struct {
-    SuffixTreeNode *node;
-} StackNode;
-
-// Iterative DFS avoids stack overflow; excludes terminator-only suffix
-static void collect_leaf_indices(SuffixTreeNode *root, int *matches, int *count, 
-                                  int capacity, int original_text_len) {
-    if (!root) return;
-    
-    int stack_capacity = 10000;
-    StackNode *stack = (StackNode*)malloc(stack_capacity * sizeof(StackNode));
-    if (!stack) return;
-    
-    int stack_top = 0;
-    stack[stack_top++].node = root;
-    
-    while (stack_top > 0) {
-        SuffixTreeNode *current = stack[--stack_top].node;
-        
-        // Leaf nodes have suffix_index >= 0; collect if not terminator
-        if (current->suffix_index >= 0) {
-            if (current->suffix_index < original_text_len && *count < capacity) {
-                matches[(*count)++] = current->suffix_index;
-            }
-            continue;
-        }
-        
-        // Internal node - add all children to stack
-        for (int i = 0; i < ALPHABET_SIZE; i++) {
-            if (current->children[i]) {
-                if (stack_top >= stack_capacity) {
-                    stack_capacity *= 2;
-                    StackNode *new_stack = (StackNode*)realloc(stack, stack_capacity * sizeof(StackNode));
-                    if (!new_stack) {
-                        free(stack);
-                        return;
-                    }
-                    stack = new_stack;
-                }
-                stack[stack_top++].node = current->children[i];
-            }
-        }
-    }
-    
-    free(stack);
-}
-
-// Safe integer comparison for qsort (avoids overflow)
-static int compare_int(const void *a, const void *b) {
-    int ia = *(int*)a;
-    int ib = *(int*)b;
-    if (ia < ib) return -1;
-    if (ia > ib) return 1;
-    return 0;
-}
-
-// Search: Walk tree O(m), collect leaves O(k), sort O(k log k)
-MatchResult suffix_tree_search(SuffixTree *tree, const char *pattern) {
-    MatchResult result;
-    result.positions = NULL;
-    result.count = 0;
-    result.time_taken = 0.0;
-    result.memory_used = 0;
-    
-    if (!tree || !pattern) return result;
-    
-    clock_t start = clock();
-    
-    int pattern_len = strlen(pattern);
-    int original_text_len = tree->size - 1;
-    
-    if (pattern_len == 0 || pattern_len > original_text_len) {
-        result.time_taken = ((double)(clock() - start)) / CLOCKS_PER_SEC * 1000.0;
-        return result;
-    }
-    
-    // Phase 1: Walk tree matching pattern
-    SuffixTreeNode *current = tree->root;
-    int pattern_pos = 0;
-    
-    while (pattern_pos < pattern_len) {
-        unsigned char c = (unsigned char)pattern[pattern_pos];
-        
-        // No edge with this character means pattern not in tree
-        if (!current->children[c]) {
-            result.time_taken = ((double)(clock() - start)) / CLOCKS_PER_SEC * 1000.0;
-            return result;
-        }
-        
-        SuffixTreeNode *child = current->children[c];
-        int edge_start = child->start;
-        int edge_end = child->end;
-        int edge_len = edge_end - edge_start + 1;
-        
-        // Compare pattern with edge label character by character
-        int matched = 0;
-        while (matched < edge_len && pattern_pos < pattern_len) {
-            if (tree->text[edge_start + matched] != pattern[pattern_pos]) {
-                result.time_taken = ((double)(clock() - start)) / CLOCKS_PER_SEC * 1000.0;
-                return result;
-            }
-            matched++;
-            pattern_pos++;
-        }
-        
-        // Pattern can end mid-edge or at node - both valid
-        if (pattern_pos == pattern_len) {
-            current = child;
-            break;
-        }
-        
-        current = child;
-    }
-    
-    // Phase 2: Collect all leaves in subtree
-    int capacity = original_text_len;
-    int *matches = (int*)malloc(capacity * sizeof(int));
-    if (!matches) {
-        result.time_taken = ((double)(clock() - start)) / CLOCKS_PER_SEC * 1000.0;
-        return result;
-    }
-    
-    int count = 0;
-    collect_leaf_indices(current, matches, &count, capacity, original_text_len);
-    
-    // Phase 3: Sort results
-    if (count > 1) {
-        qsort(matches, count, sizeof(int), compare_int);
-    }
-    
-    clock_t end = clock();
-    
-    result.positions = matches;
-    result.count = count;
-    result.time_taken = ((double)(end - start)) / CLOCKS_PER_SEC * 1000.0;
-    result.memory_used = sizeof(SuffixTree) + (tree->size + 1) + (count * sizeof(int));
-    
-    return result;
-}
-
-static void free_node(SuffixTreeNode *node) {
-    if (!node) return;
-    
-    for (int i = 0; i < ALPHABET_SIZE; i++) {
-        if (node->children[i]) {
-            free_node(node->children[i]);
-        }
-    }
-    free(node);
-}
-
-void free_suffix_tree(SuffixTree *tree) {
-    if (!tree) return;
-    
-    free_node(tree->root);
-    free(tree->text);
-    free(tree);
+/*
+ * Suffix Tree Implementation - Ukkonen's Online Construction
+ *
+ * A compressed trie of all suffixes. '$' terminator ensures uniqueness.
+ * Construction: O(n) - Ukkonen's algorithm with suffix links, the
+ *               active point and open-ended ("once a leaf, always a
+ *               leaf") edge labels
+ * Search: O(m + k) - tree walk + precomputed contiguous leaf slice
+ * Space: O(n) nodes (at most 2n - 1)
+ */
+
+#include "pattern_matching.h"
+#include <limits.h>
+
+#define ALPHABET_SIZE 256
+#define TERMINATOR '$'
+
+// Sentinel end index for leaf edges that grow with every extension.
+// Replaced by the real end index once construction finishes.
+#define OPEN_END INT_MAX
+
+// Edges are labeled with substrings via [start, end] indices into text
+typedef struct SuffixTreeNode {
+    struct SuffixTreeNode *children[ALPHABET_SIZE];
+    struct SuffixTreeNode *suffix_link;  // Ukkonen suffix link (internal nodes)
+    int start;           // Start index in text for edge label
+    int end;             // End index in text for edge label (inclusive); OPEN_END while building
+    int suffix_index;    // For leaf nodes: starting position of suffix (-1 for internal)
+    int leaf_start;      // Slice of tree->suffix_positions holding this
+    int leaf_count;      // subtree's occurrences (set by build_leaf_ranges)
+} SuffixTreeNode;
+
+// Construction state: the "active point" (node, edge, length) marks where
+// the next suffix extension starts, remaining counts implicit suffixes
+typedef struct {
+    SuffixTree *tree;
+    SuffixTreeNode *active_node;
+    SuffixTreeNode *last_new_node;  // Awaiting a suffix link this phase
+    int active_edge;                // Index into text of the active edge's first char
+    int active_length;
+    int remaining;                  // Suffixes left to add explicitly
+    int leaf_end;                   // Shared end index of all open leaf edges
+} UkkonenState;
+
+// Nodes come out of the tree's arena: a pointer bump instead of malloc,
+// contiguous placement, and no per-node free at teardown
+static SuffixTreeNode* create_node(Arena *arena, int start, int end) {
+    SuffixTreeNode *node = (SuffixTreeNode*)arena_alloc(arena, sizeof(SuffixTreeNode));
+    if (!node) return NULL;
+
+    // arena_alloc zeroes: children[] and suffix_link are already NULL
+    node->start = start;
+    node->end = end;
+    node->suffix_index = -1;
+
+    return node;
+}
+
+// Current length of a node's incoming edge (open leaf edges track leaf_end)
+static int edge_length(const UkkonenState *st, const SuffixTreeNode *node) {
+    int end = (node->end == OPEN_END) ? st->leaf_end : node->end;
+    return end - node->start + 1;
+}
+
+// Skip/count trick: if the active length spans the whole edge, hop to the
+// child node instead of comparing the edge characters one by one
+static int walk_down(UkkonenState *st, SuffixTreeNode *node) {
+    int len = edge_length(st, node);
+    if (st->active_length >= len) {
+        st->active_edge += len;
+        st->active_length -= len;
+        st->active_node = node;
+        return 1;
+    }
+    return 0;
+}
+
+// One phase of Ukkonen's algorithm: extend the tree with text[pos].
+// Returns: 0 on success, -1 on allocation failure
+static int extend_tree(UkkonenState *st, int pos) {
+    const char *text = st->tree->text;
+
+    // Rule 1 for every open leaf edge at once: bump the shared end
+    st->leaf_end = pos;
+    st->remaining++;
+    st->last_new_node = NULL;
+
+    while (st->remaining > 0) {
+        if (st->active_length == 0)
+            st->active_edge = pos;
+
+        unsigned char c = (unsigned char)text[st->active_edge];
+
+        if (!st->active_node->children[c]) {
+            // Rule 2: no edge starts with this character - new leaf
+            SuffixTreeNode *leaf = create_node(st->tree->arena, pos, OPEN_END);
+            if (!leaf) return -1;
+            st->active_node->children[c] = leaf;
+
+            // An internal node created earlier this phase gets its suffix link
+            if (st->last_new_node) {
+                st->last_new_node->suffix_link = st->active_node;
+                st->last_new_node = NULL;
+            }
+        } else {
+            SuffixTreeNode *next = st->active_node->children[c];
+            if (walk_down(st, next))
+                continue;
+
+            if (text[next->start + st->active_length] == text[pos]) {
+                // Rule 3: character already on the edge - suffix is implicit,
+                // end the phase (showstopper)
+                if (st->last_new_node && st->active_node != st->tree->root) {
+                    st->last_new_node->suffix_link = st->active_node;
+                    st->last_new_node = NULL;
+                }
+                st->active_length++;
+                break;
+            }
+
+            // Rule 2 with split: mismatch mid-edge, insert an internal node
+            SuffixTreeNode *split = create_node(st->tree->arena, next->start,
+                                                next->start + st->active_length - 1);
+            if (!split) return -1;
+            st->active_node->children[c] = split;
+
+            SuffixTreeNode *leaf = create_node(st->tree->arena, pos, OPEN_END);
+            if (!leaf) return -1;
+            split->children[(unsigned char)text[pos]] = leaf;
+
+            next->start += st->active_length;
+            split->children[(unsigned char)text[next->start]] = next;
+
+            if (st->last_new_node)
+                st->last_new_node->suffix_link = split;
+            st->last_new_node = split;
+        }
+
+        st->remaining--;
+
+        if (st->active_node == st->tree->root && st->active_length > 0) {
+            st->active_length--;
+            st->active_edge = pos - st->remaining + 1;
+        } else if (st->active_node != st->tree->root) {
+            // Follow suffix link (or fall back to root) for the next suffix
+            st->active_node = st->active_node->suffix_link ?
+                              st->active_node->suffix_link : st->tree->root;
+        }
+    }
+
+    return 0;
+}
+
+typedef struct {
+    SuffixTreeNode *node;
+    int depth;  // Length of the path label above this node's incoming edge
+} FinalizeFrame;
+
+// Post-construction pass: close open leaf edges and assign suffix indices
+// (suffix_index = n - path length). Iterative DFS avoids stack overflow.
+// Returns: 0 on success, -1 on allocation failure
+static int finalize_tree(SuffixTree *tree) {
+    int stack_capacity = 10000;
+    FinalizeFrame *stack = (FinalizeFrame*)malloc(stack_capacity * sizeof(FinalizeFrame));
+    if (!stack) return -1;
+
+    int stack_top = 0;
+    stack[stack_top].node = tree->root;
+    stack[stack_top].depth = 0;
+    stack_top++;
+
+    while (stack_top > 0) {
+        stack_top--;
+        SuffixTreeNode *current = stack[stack_top].node;
+        int depth = stack[stack_top].depth;
+
+        if (current->end == OPEN_END)
+            current->end = tree->size - 1;
+
+        int label_len = (current->start == -1) ? 0 : current->end - current->start + 1;
+        int path_len = depth + label_len;
+
+        int has_children = 0;
+        for (int i = 0; i < ALPHABET_SIZE; i++) {
+            if (current->children[i]) {
+                has_children = 1;
+                if (stack_top >= stack_capacity) {
+                    stack_capacity *= 2;
+                    FinalizeFrame *new_stack = (FinalizeFrame*)realloc(stack,
+                                               stack_capacity * sizeof(FinalizeFrame));
+                    if (!new_stack) {
+                        free(stack);
+                        return -1;
+                    }
+                    stack = new_stack;
+                }
+                stack[stack_top].node = current->children[i];
+                stack[stack_top].depth = path_len;
+                stack_top++;
+            }
+        }
+
+        if (!has_children) {
+            current->suffix_index = tree->size - path_len;
+        }
+    }
+
+    free(stack);
+    return 0;
+}
+
+typedef struct {
+    SuffixTreeNode *node;
+    int entered;  // 0: record slice start and expand; 1: close the slice
+} RangeFrame;
+
+// Euler-tour pass: lays every leaf's suffix index into one global array
+// so each node owns a contiguous [leaf_start, leaf_start + leaf_count)
+// slice covering its whole subtree. Queries then return a slice instead
+// of walking the subtree - no DFS, no stack, no per-query allocation
+// churn. The terminator-only suffix is excluded here once, not per query.
+// Returns: 0 on success, -1 on allocation failure
+static int build_leaf_ranges(SuffixTree *tree) {
+    int original_text_len = tree->size - 1;
+
+    tree->suffix_positions = (int*)malloc(tree->size * sizeof(int));
+    if (!tree->suffix_positions) return -1;
+    tree->num_suffixes = 0;
+
+    int stack_capacity = 10000;
+    RangeFrame *stack = (RangeFrame*)malloc(stack_capacity * sizeof(RangeFrame));
+    if (!stack) return -1;
+
+    int stack_top = 0;
+    stack[stack_top].node = tree->root;
+    stack[stack_top].entered = 0;
+    stack_top++;
+
+    while (stack_top > 0) {
+        stack_top--;
+        SuffixTreeNode *current = stack[stack_top].node;
+
+        if (stack[stack_top].entered) {
+            current->leaf_count = tree->num_suffixes - current->leaf_start;
+            continue;
+        }
+
+        current->leaf_start = tree->num_suffixes;
+
+        if (current->suffix_index >= 0) {
+            // Leaf: one occurrence, unless it is the terminator-only suffix
+            if (current->suffix_index < original_text_len) {
+                tree->suffix_positions[tree->num_suffixes++] = current->suffix_index;
+            }
+            current->leaf_count = tree->num_suffixes - current->leaf_start;
+            continue;
+        }
+
+        // Internal node: close the slice after the subtree is done
+        if (stack_top + 1 + ALPHABET_SIZE > stack_capacity) {
+            stack_capacity *= 2;
+            RangeFrame *new_stack = (RangeFrame*)realloc(stack,
+                                    stack_capacity * sizeof(RangeFrame));
+            if (!new_stack) {
+                free(stack);
+                return -1;
+            }
+            stack = new_stack;
+        }
+        stack[stack_top].node = current;
+        stack[stack_top].entered = 1;
+        stack_top++;
+
+        // Push in reverse so children pop in ascending character order
+        for (int i = ALPHABET_SIZE - 1; i >= 0; i--) {
+            if (current->children[i]) {
+                stack[stack_top].node = current->children[i];
+                stack[stack_top].entered = 0;
+                stack_top++;
+            }
+        }
+    }
+
+    free(stack);
+    return 0;
+}
+
+// Appends '$' terminator to ensure all suffixes end at unique leaf nodes
+SuffixTree* create_suffix_tree(const char *text) {
+    if (!text) return NULL;
+
+    int original_len = strlen(text);
+
+    SuffixTree *tree = (SuffixTree*)malloc(sizeof(SuffixTree));
+    if (!tree) return NULL;
+
+    tree->text = (char*)malloc(original_len + 2);
+    if (!tree->text) {
+        free(tree);
+        return NULL;
+    }
+
+    strcpy(tree->text, text);
+    tree->text[original_len] = TERMINATOR;
+    tree->text[original_len + 1] = '\0';
+    tree->size = original_len + 1;
+    tree->suffix_positions = NULL;
+    tree->num_suffixes = 0;
+
+    tree->arena = arena_create(0);
+    if (!tree->arena) {
+        free(tree->text);
+        free(tree);
+        return NULL;
+    }
+
+    // Root has no incoming edge: start=-1, end=-1
+    tree->root = create_node(tree->arena, -1, -1);
+    if (!tree->root) {
+        free_suffix_tree(tree);
+        return NULL;
+    }
+
+    // Build tree online, one phase per character (O(n) total)
+    UkkonenState st;
+    st.tree = tree;
+    st.active_node = tree->root;
+    st.last_new_node = NULL;
+    st.active_edge = 0;
+    st.active_length = 0;
+    st.remaining = 0;
+    st.leaf_end = -1;
+
+    for (int i = 0; i < tree->size; i++) {
+        if (extend_tree(&st, i) < 0) {
+            free_suffix_tree(tree);
+            return NULL;
+        }
+    }
+
+    if (finalize_tree(tree) < 0) {
+        free_suffix_tree(tree);
+        return NULL;
+    }
+
+    if (build_leaf_ranges(tree) < 0) {
+        free_suffix_tree(tree);
+        return NULL;
+    }
+
+    return tree;
+}
+
+// Safe integer comparison for qsort (avoids overflow)
+static int compare_int(const void *a, const void *b) {
+    int ia = *(int*)a;
+    int ib = *(int*)b;
+    if (ia < ib) return -1;
+    if (ia > ib) return 1;
+    return 0;
+}
+
+// Walks the pattern down from the root (O(m)); returns the node whose
+// leaf slice covers every occurrence, or NULL if the pattern is absent
+static SuffixTreeNode* walk_pattern(const SuffixTree *tree, const char *pattern,
+                                    int pattern_len) {
+    SuffixTreeNode *current = tree->root;
+    int pattern_pos = 0;
+
+    while (pattern_pos < pattern_len) {
+        unsigned char c = (unsigned char)pattern[pattern_pos];
+
+        // No edge with this character means pattern not in tree
+        if (!current->children[c]) return NULL;
+
+        SuffixTreeNode *child = current->children[c];
+        int edge_start = child->start;
+        int edge_len = child->end - edge_start + 1;
+
+        // Compare pattern with edge label character by character;
+        // the pattern may end mid-edge or at the node - both valid
+        int matched = 0;
+        while (matched < edge_len && pattern_pos < pattern_len) {
+            if (tree->text[edge_start + matched] != pattern[pattern_pos]) {
+                return NULL;
+            }
+            matched++;
+            pattern_pos++;
+        }
+
+        current = child;
+    }
+
+    return current;
+}
+
+// Search: Walk tree O(m), copy the node's precomputed leaf slice O(k).
+// The slice is in Euler-tour (lexicographic) order; the copy is sorted
+// into position order to match every other matcher's output.
+MatchResult suffix_tree_search(SuffixTree *tree, const char *pattern) {
+    MatchResult result;
+    init_match_result(&result);
+
+    if (!tree || !pattern) return result;
+
+    PerfTimer timer;
+    perf_timer_start(&timer);
+
+    int pattern_len = strlen(pattern);
+    int original_text_len = tree->size - 1;
+
+    if (pattern_len == 0 || pattern_len > original_text_len) {
+        perf_timer_stop(&timer, &result);
+        return result;
+    }
+
+    // Phase 1: Walk tree matching pattern
+    SuffixTreeNode *current = walk_pattern(tree, pattern, pattern_len);
+    if (!current) {
+        perf_timer_stop(&timer, &result);
+        return result;
+    }
+
+    // Phase 2: The node's leaf slice is the full occurrence list
+    int count = current->leaf_count;
+    if (count == 0) {
+        perf_timer_stop(&timer, &result);
+        return result;
+    }
+
+    int *matches = (int*)malloc(count * sizeof(int));
+    if (!matches) {
+        perf_timer_stop(&timer, &result);
+        return result;
+    }
+    memcpy(matches, tree->suffix_positions + current->leaf_start,
+           count * sizeof(int));
+
+    // Phase 3: Sort into position order
+    if (count > 1) {
+        qsort(matches, count, sizeof(int), compare_int);
+    }
+
+    perf_timer_stop(&timer, &result);
+
+    result.positions = matches;
+    result.count = count;
+    result.memory_used = sizeof(SuffixTree) + (tree->size + 1) + (count * sizeof(int));
+
+    return result;
+}
+
+// Sort support for the batch API: order pattern indices so probes with
+// shared prefixes become neighbours (static context, same style as the
+// FM-index suffix sort)
+static const char **many_sort_patterns;
+
+static int compare_pattern_index(const void *a, const void *b) {
+    return strcmp(many_sort_patterns[*(const int *)a],
+                  many_sort_patterns[*(const int *)b]);
+}
+
+// Node chain along the current root path, one entry per fully entered
+// node; depth is the path length where the node's edge ends
+typedef struct {
+    SuffixTreeNode *node;
+    int depth;
+} PathEntry;
+
+/**
+ * Batched probe-panel queries: runs pattern_count patterns against one
+ * tree in a single pass. Patterns are processed in sorted order and the
+ * walk resumes from the deepest node still covered by the longest
+ * common prefix with the previous probe, so shared root paths are
+ * descended once instead of once per pattern. Results come back in the
+ * caller's pattern order; per-result timing is zero - the batch is the
+ * meaningful unit, timed by the caller. Caller frees each result with
+ * free_match_result() and then the array.
+ * Returns: array of pattern_count results, or NULL on failure
+ */
+MatchResult* suffix_tree_search_many(SuffixTree *tree, const char **patterns,
+                                     int pattern_count) {
+    if (!tree || !patterns || pattern_count <= 0) return NULL;
+
+    MatchResult *results = (MatchResult *)malloc(pattern_count * sizeof(MatchResult));
+    int *order = (int *)malloc(pattern_count * sizeof(int));
+    if (!results || !order) {
+        free(results);
+        free(order);
+        return NULL;
+    }
+
+    int max_m = 0;
+    for (int i = 0; i < pattern_count; i++) {
+        init_match_result(&results[i]);
+        order[i] = i;
+        int m = patterns[i] ? (int)strlen(patterns[i]) : 0;
+        if (m > max_m) max_m = m;
+    }
+
+    many_sort_patterns = patterns;
+    qsort(order, pattern_count, sizeof(int), compare_pattern_index);
+
+    PathEntry *chain = (PathEntry *)malloc((max_m + 2) * sizeof(PathEntry));
+    if (!chain) {
+        free(results);
+        free(order);
+        return NULL;
+    }
+    chain[0].node = tree->root;
+    chain[0].depth = 0;
+    int chain_top = 0;
+
+    const char *prev = NULL;
+    int original_text_len = tree->size - 1;
+
+    for (int s = 0; s < pattern_count; s++) {
+        const char *pattern = patterns[order[s]];
+        MatchResult *out = &results[order[s]];
+        int m = pattern ? (int)strlen(pattern) : 0;
+
+        if (m == 0 || m > original_text_len) {
+            prev = pattern;
+            chain_top = 0;  // Nothing verified for the next probe
+            continue;
+        }
+
+        // Resume below the prefix shared with the previous probe
+        int lcp = 0;
+        if (prev) {
+            while (prev[lcp] && pattern[lcp] && prev[lcp] == pattern[lcp]) lcp++;
+        }
+        while (chain_top > 0 && chain[chain_top].depth > lcp) chain_top--;
+
+        SuffixTreeNode *current = chain[chain_top].node;
+        int pos = chain[chain_top].depth;
+        SuffixTreeNode *terminal = NULL;
+        int failed = 0;
+
+        while (pos < m) {
+            SuffixTreeNode *child = current->children[(unsigned char)pattern[pos]];
+            if (!child) {
+                failed = 1;
+                break;
+            }
+
+            int edge_start = child->start;
+            int edge_len = child->end - edge_start + 1;
+            int matched = 0;
+            while (matched < edge_len && pos < m) {
+                if (tree->text[edge_start + matched] != pattern[pos]) {
+                    failed = 1;
+                    break;
+                }
+                matched++;
+                pos++;
+            }
+            if (failed) break;
+
+            if (matched == edge_len) {
+                current = child;
+                chain_top++;
+                chain[chain_top].node = child;
+                chain[chain_top].depth = pos;
+            } else {
+                terminal = child;  // Pattern ended mid-edge
+                break;
+            }
+        }
+
+        if (!failed) {
+            if (!terminal) terminal = current;
+            int count = terminal->leaf_count;
+            if (count > 0) {
+                int *matches = (int *)malloc(count * sizeof(int));
+                if (matches) {
+                    memcpy(matches, tree->suffix_positions + terminal->leaf_start,
+                           count * sizeof(int));
+                    if (count > 1) qsort(matches, count, sizeof(int), compare_int);
+                    out->positions = matches;
+                    out->count = count;
+                    out->memory_used = count * sizeof(int);
+                }
+            }
+        }
+
+        prev = pattern;
+    }
+
+    free(chain);
+    free(order);
+    return results;
+}
+
+// Count-only query: O(m) walk, then the precomputed leaf_count - no
+// position array, no allocation. positions stays NULL.
+MatchResult suffix_tree_count(SuffixTree *tree, const char *pattern) {
+    MatchResult result;
+    init_match_result(&result);
+
+    if (!tree || !pattern) return result;
+
+    PerfTimer timer;
+    perf_timer_start(&timer);
+
+    int pattern_len = strlen(pattern);
+    if (pattern_len > 0 && pattern_len <= tree->size - 1) {
+        SuffixTreeNode *node = walk_pattern(tree, pattern, pattern_len);
+        if (node) result.count = node->leaf_count;
+    }
+
+    perf_timer_stop(&timer, &result);
+    return result;
+}
+
+// All nodes live in the arena - no per-node walk, teardown is O(blocks)
+void free_suffix_tree(SuffixTree *tree) {
+    if (!tree) return;
+
+    arena_destroy(tree->arena);
+    free(tree->suffix_positions);
+    free(tree->text);
+    free(tree);
 }
\ No newline at end of file
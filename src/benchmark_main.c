@@ -0,0 +1,303 @@
+/*
+ * Native Benchmark Harness - DNA Pattern Matching Suite
+ *
+ * In-process benchmarking: loads the corpus once, runs warmup
+ * iterations, times every algorithm with clock_gettime(CLOCK_MONOTONIC)
+ * and reports min/median/p99/mean plus throughput in machine-readable
+ * CSV (default) or JSON. Index structures (suffix tree, FM-index) are
+ * built once outside the timed region so query cost is measured, not
+ * construction. Build with `make benchmark`.
+ *
+ * Usage: benchmark <fasta> <pattern> [iterations] [--json]
+ */
+
+#define _GNU_SOURCE
+#include "pattern_matching.h"
+
+#define DEFAULT_ITERATIONS 21
+#define WARMUP_ITERATIONS 3
+
+typedef struct {
+    const char *name;
+    double *samples;     // Wall-clock milliseconds per iteration
+    int iterations;
+    int match_count;
+} BenchEntry;
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+static int compare_double(const void *a, const void *b) {
+    double da = *(const double *)a;
+    double db = *(const double *)b;
+    if (da < db) return -1;
+    if (da > db) return 1;
+    return 0;
+}
+
+// Nearest-rank percentile over a sorted sample array
+static double percentile(const double *sorted, int n, double p) {
+    int rank = (int)(p / 100.0 * n + 0.5);
+    if (rank < 1) rank = 1;
+    if (rank > n) rank = n;
+    return sorted[rank - 1];
+}
+
+// Benchmarked operation: returns the match count for sanity checking
+typedef int (*bench_fn)(const char *text, size_t text_len, const char *pattern, void *ctx);
+
+static int bench_run(BenchEntry *entry, bench_fn fn, const char *text, size_t text_len,
+                     const char *pattern, void *ctx, int iterations) {
+    entry->samples = (double *)malloc(iterations * sizeof(double));
+    if (!entry->samples) return -1;
+    entry->iterations = iterations;
+
+    for (int i = 0; i < WARMUP_ITERATIONS; i++) {
+        entry->match_count = fn(text, text_len, pattern, ctx);
+    }
+    for (int i = 0; i < iterations; i++) {
+        double t0 = now_ms();
+        entry->match_count = fn(text, text_len, pattern, ctx);
+        entry->samples[i] = now_ms() - t0;
+    }
+
+    qsort(entry->samples, iterations, sizeof(double), compare_double);
+    return 0;
+}
+
+/* ---- Wrappers for each measured operation ---- */
+
+static int run_naive(const char *t, size_t n, const char *p, void *ctx) {
+    (void)n; (void)ctx;
+    MatchResult r = naive_search(t, p);
+    int c = r.count;
+    free_match_result(&r);
+    return c;
+}
+
+static int run_kmp(const char *t, size_t n, const char *p, void *ctx) {
+    (void)n; (void)ctx;
+    MatchResult r = kmp_search(t, p);
+    int c = r.count;
+    free_match_result(&r);
+    return c;
+}
+
+static int run_boyer_moore(const char *t, size_t n, const char *p, void *ctx) {
+    (void)n; (void)ctx;
+    MatchResult r = boyer_moore_search(t, p);
+    int c = r.count;
+    free_match_result(&r);
+    return c;
+}
+
+static int run_rabin_karp(const char *t, size_t n, const char *p, void *ctx) {
+    (void)n; (void)ctx;
+    MatchResult r = rabin_karp_search(t, p);
+    int c = r.count;
+    free_match_result(&r);
+    return c;
+}
+
+static int run_z(const char *t, size_t n, const char *p, void *ctx) {
+    (void)n; (void)ctx;
+    MatchResult r = z_algorithm_search(t, p);
+    int c = r.count;
+    free_match_result(&r);
+    return c;
+}
+
+static int run_shift_or(const char *t, size_t n, const char *p, void *ctx) {
+    (void)n; (void)ctx;
+    MatchResult r = shift_or_search(t, p);
+    int c = r.count;
+    free_match_result(&r);
+    return c;
+}
+
+static int run_simd(const char *t, size_t n, const char *p, void *ctx) {
+    (void)n; (void)ctx;
+    MatchResult r = simd_search(t, p);
+    int c = r.count;
+    free_match_result(&r);
+    return c;
+}
+
+static int run_parallel(const char *t, size_t n, const char *p, void *ctx) {
+    (void)ctx;
+    MatchResult r = parallel_search(SEARCH_ALGO_BOYER_MOORE, t, n, p, 0);
+    int c = r.count;
+    free_match_result(&r);
+    return c;
+}
+
+static int run_compiled_kmp(const char *t, size_t n, const char *p, void *ctx) {
+    (void)p;
+    MatchResult r = search_compiled((const CompiledPattern *)ctx, t, n);
+    int c = r.count;
+    free_match_result(&r);
+    return c;
+}
+
+static int run_suffix_tree_query(const char *t, size_t n, const char *p, void *ctx) {
+    (void)t; (void)n;
+    MatchResult r = suffix_tree_search((SuffixTree *)ctx, p);
+    int c = r.count;
+    free_match_result(&r);
+    return c;
+}
+
+static int run_fm_index_query(const char *t, size_t n, const char *p, void *ctx) {
+    (void)t; (void)n;
+    MatchResult r = fm_index_search((FMIndex *)ctx, p);
+    int c = r.count;
+    free_match_result(&r);
+    return c;
+}
+
+/* ---- Reporting ---- */
+
+static void report_csv(const BenchEntry *entries, int count, size_t text_len) {
+    printf("algorithm,matches,iterations,min_ms,median_ms,p99_ms,mean_ms,throughput_mb_s\n");
+    for (int i = 0; i < count; i++) {
+        const BenchEntry *e = &entries[i];
+        double mean = 0.0;
+        for (int j = 0; j < e->iterations; j++) mean += e->samples[j];
+        mean /= e->iterations;
+        double median = percentile(e->samples, e->iterations, 50.0);
+        double mb_s = (median > 0.0)
+                      ? (text_len / (1024.0 * 1024.0)) / (median / 1000.0) : 0.0;
+        printf("%s,%d,%d,%.4f,%.4f,%.4f,%.4f,%.2f\n",
+               e->name, e->match_count, e->iterations,
+               e->samples[0], median,
+               percentile(e->samples, e->iterations, 99.0), mean, mb_s);
+    }
+}
+
+static void report_json(const BenchEntry *entries, int count, size_t text_len) {
+    printf("[\n");
+    for (int i = 0; i < count; i++) {
+        const BenchEntry *e = &entries[i];
+        double mean = 0.0;
+        for (int j = 0; j < e->iterations; j++) mean += e->samples[j];
+        mean /= e->iterations;
+        double median = percentile(e->samples, e->iterations, 50.0);
+        double mb_s = (median > 0.0)
+                      ? (text_len / (1024.0 * 1024.0)) / (median / 1000.0) : 0.0;
+        printf("  {\"algorithm\": \"%s\", \"matches\": %d, \"iterations\": %d, "
+               "\"min_ms\": %.4f, \"median_ms\": %.4f, \"p99_ms\": %.4f, "
+               "\"mean_ms\": %.4f, \"throughput_mb_s\": %.2f}%s\n",
+               e->name, e->match_count, e->iterations,
+               e->samples[0], median,
+               percentile(e->samples, e->iterations, 99.0), mean, mb_s,
+               (i < count - 1) ? "," : "");
+    }
+    printf("]\n");
+}
+
+int main(int argc, char *argv[]) {
+    // One-off per-machine calibration for the auto search mode
+    if (argc >= 2 && strcmp(argv[1], "--calibrate") == 0) {
+        const char *path = (argc >= 3) ? argv[2] : NULL;
+        printf("Calibrating exact matchers on a 1 MB synthetic corpus...\n");
+        if (calibrate_auto_search(path) != 0) {
+            fprintf(stderr, "Calibration failed\n");
+            return 1;
+        }
+        printf("Calibration profile written (%s)\n",
+               path ? path : "data/calibration.profile");
+        return 0;
+    }
+
+    if (argc < 3) {
+        fprintf(stderr, "Usage: %s <fasta> <pattern> [iterations] [--json]\n", argv[0]);
+        fprintf(stderr, "       %s --calibrate [profile-path]\n", argv[0]);
+        return 1;
+    }
+
+    const char *fasta = argv[1];
+    const char *pattern = argv[2];
+    int iterations = DEFAULT_ITERATIONS;
+    int json = 0;
+
+    for (int i = 3; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0) {
+            json = 1;
+        } else {
+            iterations = atoi(argv[i]);
+            if (iterations < 1) iterations = DEFAULT_ITERATIONS;
+        }
+    }
+
+    // Load corpus once - all measurements amortize this
+    DNASequence *seq = load_fasta_file_mmap(fasta);
+    if (!seq) seq = load_fasta_file(fasta);
+    if (!seq) {
+        fprintf(stderr, "Error loading %s\n", fasta);
+        return 1;
+    }
+
+    size_t m = strlen(pattern);
+    fprintf(stderr, "Corpus: %zu bases, pattern: %zu chars, %d iterations (+%d warmup)\n",
+            seq->length, m, iterations, WARMUP_ITERATIONS);
+
+    // One-time index construction, excluded from the timed region
+    fprintf(stderr, "Building suffix tree and FM-index...\n");
+    SuffixTree *tree = create_suffix_tree(seq->sequence);
+    FMIndex *fm = create_fm_index(seq->sequence);
+    CompiledPattern *compiled = compile_pattern(pattern, SEARCH_ALGO_KMP);
+
+    BenchEntry entries[16];
+    int count = 0;
+
+    struct {
+        const char *name;
+        bench_fn fn;
+        void *ctx;
+        int enabled;
+    } cases[] = {
+        { "naive",             run_naive,             NULL,     1 },
+        { "kmp",               run_kmp,               NULL,     1 },
+        { "boyer_moore",       run_boyer_moore,       NULL,     1 },
+        { "rabin_karp",        run_rabin_karp,        NULL,     1 },
+        { "z_algorithm",       run_z,                 NULL,     1 },
+        { "shift_or",          run_shift_or,          NULL,     1 },
+        { "simd_prefilter",    run_simd,              NULL,     1 },
+        { "parallel_bm",       run_parallel,          NULL,     1 },
+        { "compiled_kmp",      run_compiled_kmp,      compiled, compiled != NULL },
+        { "suffix_tree_query", run_suffix_tree_query, tree,     tree != NULL },
+        { "fm_index_query",    run_fm_index_query,    fm,       fm != NULL },
+    };
+
+    int num_cases = (int)(sizeof(cases) / sizeof(cases[0]));
+    for (int i = 0; i < num_cases; i++) {
+        if (!cases[i].enabled) continue;
+        entries[count].name = cases[i].name;
+        if (bench_run(&entries[count], cases[i].fn, seq->sequence, seq->length,
+                      pattern, cases[i].ctx, iterations) < 0) {
+            fprintf(stderr, "Benchmark allocation failed for %s\n", cases[i].name);
+            continue;
+        }
+        fprintf(stderr, "  %s done\n", cases[i].name);
+        count++;
+    }
+
+    if (json) {
+        report_json(entries, count, seq->length);
+    } else {
+        report_csv(entries, count, seq->length);
+    }
+
+    for (int i = 0; i < count; i++) {
+        free(entries[i].samples);
+    }
+    free_compiled_pattern(compiled);
+    free_fm_index(fm);
+    free_suffix_tree(tree);
+    free_dna_sequence(seq);
+
+    return 0;
+}
@@ -1,723 +1,1478 @@
-/*
- * Main Program - DNA Pattern Matching Suite
- * Implements and benchmarks multiple pattern matching algorithms
- */
-
-#define _GNU_SOURCE
-#include "pattern_matching.h"
-#include <regex.h>
-
-void print_algorithm_info(int choice) {
-    printf("\n[INFO] \033[1;34mAlgorithm Explanation:\033[0m\n");
-    switch(choice) {
-        case 3: // KMP
-            printf("   \033[1mKnuth-Morris-Pratt (KMP)\033[0m is an efficient exact matching algorithm.\n");
-            printf("   It preprocesses the pattern to create a 'Longest Prefix Suffix' (LPS) array.\n");
-            printf("   This allows it to skip unnecessary comparisons when a mismatch occurs, ensuring\n");
-            printf("   we never go backwards in the text. Time Complexity: O(n+m).\n");
-            break;
-        case 15: // Naive
-            printf("   \033[1mNaive (Brute Force)\033[0m is the simplest pattern matching algorithm.\n");
-            printf("   It checks for the pattern at every possible position in the text.\n");
-            printf("   Useful for verifying the correctness of more complex algorithms.\n");
-            printf("   Time Complexity: O(nm).\n");
-            break;
-        case 4: // Boyer-Moore
-            printf("   \033[1mBoyer-Moore\033[0m is often the fastest algorithm for standard text.\n");
-            printf("   It scans the pattern from right to left and uses two heuristics (Bad Character\n");
-            printf("   and Good Suffix) to skip large chunks of text when a mismatch is found.\n");
-            printf("   Time Complexity: Average O(n/m), Worst O(nm).\n");
-            break;
-        case 5: // Suffix Tree
-            printf("   \033[1mSuffix Tree\033[0m is a compressed trie of all text suffixes.\n");
-            printf("   It builds an explicit tree structure with '$' terminator ensuring unique leaves.\n");
-            printf("   Construction: O(n²) via explicit suffix insertion. Search: O(m) tree walk.\n");
-            printf("   Ideal for multiple pattern queries on the same text after preprocessing.\n");
-            break;
-        case 6: // Shift-Or
-            printf("   \033[1mShift-Or (Bitap)\033[0m uses bitwise operations to simulate a non-deterministic automaton.\n");
-            printf("   It is extremely fast for short patterns (<= 64 chars) because it processes the text\n");
-            printf("   using native CPU bit operations. Time Complexity: O(n).\n");
-            break;
-        case 11: // Rabin-Karp
-            printf("   \033[1mRabin-Karp\033[0m uses hashing.\n");
-            printf("   It calculates a 'fingerprint' (hash) for the pattern and for every window of text.\n");
-            printf("   If hashes match, it checks the characters. It uses a 'rolling hash' to update\n");
-            printf("   the hash value quickly as it moves through the text.\n");
-            break;
-        case 12: // Z-Algorithm
-            printf("   \033[1mZ-Algorithm\033[0m computes a 'Z-array'.\n");
-            printf("   For every position in the text, it calculates the length of the longest substring\n");
-            printf("   starting there that matches the prefix of the string. It's a fundamental linear-time method.\n");
-            break;
-        case 7: // Levenshtein
-            printf("   \033[1mLevenshtein Distance\033[0m finds 'fuzzy' matches.\n");
-            printf("   It allows for errors (insertions, deletions, substitutions). We search for substrings\n");
-            printf("   in the text that are within a specific 'edit distance' from your pattern.\n");
-            break;
-        case 13: // Aho-Corasick
-            printf("   \033[1mAho-Corasick\033[0m is designed for finding *multiple* patterns at once.\n");
-            printf("   It builds a finite automaton (Trie) of all patterns with 'failure links'.\n");
-            printf("   It scans the text once and tells us whenever *any* of the patterns are found.\n");
-            break;
-    }
-    printf("   ---------------------------------------------------------\n");
-}
-
-void print_menu() {
-    printf("\n+========================================================+\n");
-    printf("|   DNA Pattern Matching Algorithm Suite (8 Algorithms)  |\n");
-    printf("+========================================================+\n");
-    printf("\n=== Exact Matching Algorithms ===\n");
-    printf("3. Run KMP Algorithm\n");
-    printf("15. Run Naive (Brute Force) Algorithm\n");
-    printf("4. Run Boyer-Moore Algorithm\n");
-    printf("5. Run Suffix Tree Algorithm\n");
-    printf("6. Run Shift-Or Algorithm\n");
-    printf("11. Run Rabin-Karp Algorithm (Rolling Hash)\n");
-    printf("12. Run Z-Algorithm\n");
-    printf("\n=== Approximate/Multi-Pattern Matching ===\n");
-    printf("7. Run Levenshtein Distance Search (Approximate)\n");
-    printf("13. Run Aho-Corasick (Multiple Pattern Matching)\n");
-    printf("\n=== Benchmarking & Testing ===\n");
-    printf("8. Compare all algorithms (Exact Match)\n");
-    printf("9. Benchmark with Python regex comparison\n");
-    printf("10. Run comprehensive test suite\n");
-    printf("\n=== Data Management ===\n");
-    printf("1. Load DNA sequence from FASTA file\n");
-    printf("2. Generate random DNA sequence\n");
-    printf("\n0. Exit\n");
-    printf("\nEnter your choice: ");
-}
-
-MatchResult regex_search(const char *text, const char *pattern) {
-    MatchResult result;
-    result.positions = NULL;
-    result.count = 0;
-    result.time_taken = 0.0;
-    result.memory_used = 0;
-    
-    clock_t start = clock();
-    
-    regex_t regex;
-    regmatch_t match;
-    
-    if (regcomp(&regex, pattern, REG_EXTENDED) != 0) {
-        fprintf(stderr, "Failed to compile regex\n");
-        return result;
-    }
-    
-    int capacity = 100;
-    int *matches = (int *)malloc(capacity * sizeof(int));
-    int count = 0;
-    
-    const char *p = text;
-    int offset = 0;
-    
-    while (regexec(&regex, p, 1, &match, 0) == 0) {
-        if (count >= capacity) {
-            capacity *= 2;
-            int *temp = (int *)realloc(matches, capacity * sizeof(int));
-            if (!temp) {
-                free(matches);
-                regfree(&regex);
-                return result;
-            }
-            matches = temp;
-        }
-        
-        matches[count++] = offset + match.rm_so;
-        p += match.rm_so + 1;
-        offset += match.rm_so + 1;
-    }
-    
-    regfree(&regex);
-    
-    clock_t end = clock();
-    
-    result.positions = matches;
-    result.count = count;
-    result.time_taken = ((double)(end - start)) / CLOCKS_PER_SEC * 1000.0;
-    
-    return result;
-}
-
-void compare_all_algorithms(const char *text, const char *pattern) {
-    printf("\n+====================================================================+\n");
-    printf("|        [COMP] Comparing All Exact Matching Algorithms        |\n");
-    printf("+====================================================================+\n");
-    printf("\n  [LEN ] Text length: %zu\n", strlen(text));
-    printf("  [LEN ] Pattern length: %zu\n", strlen(pattern));
-    printf("  [PATT] Pattern: %s\n", pattern);
-    
-    // Naive
-    MatchResult naive_result = naive_search(text, pattern);
-    print_match_result("Naive Algorithm", &naive_result);
-
-    // KMP
-    MatchResult kmp_result = kmp_search(text, pattern);
-    print_match_result("KMP Algorithm", &kmp_result);
-    
-    // Boyer-Moore
-    MatchResult bm_result = boyer_moore_search(text, pattern);
-    print_match_result("Boyer-Moore Algorithm", &bm_result);
-    
-    // Suffix Tree
-    printf("\n[TREE] Building Suffix Tree...\n");
-    clock_t st_start = clock();
-    SuffixTree *tree = create_suffix_tree(text);
-    clock_t st_end = clock();
-    double construction_time = ((double)(st_end - st_start)) / CLOCKS_PER_SEC * 1000.0;
-    printf("   Construction time: %.3f ms\n", construction_time);
-    
-    MatchResult st_result = suffix_tree_search(tree, pattern);
-    print_match_result("Suffix Tree Algorithm", &st_result);
-    free_suffix_tree(tree);
-    
-    // Shift-Or
-    MatchResult so_result;
-    so_result.count = 0;
-    so_result.time_taken = 0;
-    so_result.memory_used = 0;
-    so_result.positions = NULL;
-    
-    if (strlen(pattern) <= 64) {
-        so_result = shift_or_search(text, pattern);
-        print_match_result("Shift-Or Algorithm", &so_result);
-    } else {
-        printf("\n[WARN]  Shift-Or: Pattern too long (max 64 characters)\n");
-    }
-    
-    // Rabin-Karp
-    MatchResult rk_result = rabin_karp_search(text, pattern);
-    print_match_result("Rabin-Karp Algorithm", &rk_result);
-    
-    // Z-Algorithm
-    MatchResult z_result = z_algorithm_search(text, pattern);
-    print_match_result("Z-Algorithm", &z_result);
-    
-    // Verify correctness
-    printf("\n+----------------------------------+\n");
-    printf("|  [ OK ] Correctness Verification |\n");
-    printf("+----------------------------------+\n");
-    printf("  Naive matches verified: %s\n", 
-           (naive_result.count == kmp_result.count) ? "[ OK ] YES" : "[FAIL] NO");
-    
-    int all_match = (naive_result.count == kmp_result.count &&
-                     kmp_result.count == bm_result.count && 
-                     bm_result.count == st_result.count &&
-                     st_result.count == so_result.count &&
-                     so_result.count == rk_result.count &&
-                     rk_result.count == z_result.count);
-    printf("  All algorithms agree: %s\n", all_match ? "[ OK ] YES" : "[WARN]  NO");
-    
-    // Summary comparison
-    printf("\n+----------------------------------------------------------------------+\n");
-    printf("|        [STAT] Performance Summary (All Algorithms)          |\n");
-    printf("+----------------------------------------------------------------------+\n\n");
-    printf("  %-20s | %10s | %15s | %15s\n", "Algorithm", "Matches", "Time (ms)", "Memory (bytes)");
-    printf("  ---------------------------------------------------------------\n");
-    printf("  %-20s | %10d | %15.3f | %15zu\n", "Naive", naive_result.count, 
-           naive_result.time_taken, naive_result.memory_used);
-    printf("  %-20s | %10d | %15.3f | %15zu\n", "KMP", kmp_result.count, 
-           kmp_result.time_taken, kmp_result.memory_used);
-    printf("  %-20s | %10d | %15.3f | %15zu\n", "Boyer-Moore", bm_result.count,
-           bm_result.time_taken, bm_result.memory_used);
-    printf("  %-20s | %10d | %15.3f | %15zu\n", "Suffix Tree", st_result.count,
-           st_result.time_taken, st_result.memory_used);
-    printf("  %-20s | %10d | %15.3f | %15zu\n", "Shift-Or", so_result.count,
-           so_result.time_taken, so_result.memory_used);
-    printf("  %-20s | %10d | %15.3f | %15zu\n", "Rabin-Karp", rk_result.count,
-           rk_result.time_taken, rk_result.memory_used);
-    printf("  %-20s | %10d | %15.3f | %15zu\n", "Z-Algorithm", z_result.count,
-           z_result.time_taken, z_result.memory_used);
-    
-    // Find fastest
-    double min_time = naive_result.time_taken;
-    const char *fastest = "Naive";
-
-    if (kmp_result.time_taken < min_time) {
-        min_time = kmp_result.time_taken;
-        fastest = "KMP";
-    }
-    
-    if (bm_result.time_taken < min_time) {
-        min_time = bm_result.time_taken;
-        fastest = "Boyer-Moore";
-    }
-    if (st_result.time_taken < min_time) {
-        min_time = st_result.time_taken;
-        fastest = "Suffix Tree";
-    }
-    if (so_result.time_taken < min_time && strlen(pattern) <= 64) {
-        min_time = so_result.time_taken;
-        fastest = "Shift-Or";
-    }
-    if (rk_result.time_taken < min_time) {
-        min_time = rk_result.time_taken;
-        fastest = "Rabin-Karp";
-    }
-    if (z_result.time_taken < min_time) {
-        min_time = z_result.time_taken;
-        fastest = "Z-Algorithm";
-    }
-    
-    printf("\n  [BEST] Fastest algorithm: %s (%.3f ms)\n", fastest, min_time);
-    
-    // Cleanup
-    free_match_result(&naive_result);
-    free_match_result(&kmp_result);
-    free_match_result(&bm_result);
-    free_match_result(&st_result);
-    free_match_result(&so_result);
-    free_match_result(&rk_result);
-    free_match_result(&z_result);
-}
-
-void run_comprehensive_tests() {
-    printf("\n+========================================================+\n");
-    printf("|           Comprehensive Test Suite                     |\n");
-    printf("+========================================================+\n");
-    
-    // Test 1: Simple pattern
-    printf("\n--- Test 1: Simple Pattern ---\n");
-    const char *text1 = "ACGTACGTACGT";
-    const char *pattern1 = "ACG";
-    compare_all_algorithms(text1, pattern1);
-    
-    // Test 2: Non-overlapping patterns
-    printf("\n\n--- Test 2: Non-overlapping Pattern ---\n");
-    const char *text2 = "AAAACAAAACAAAAC";
-    const char *pattern2 = "AAAC";
-    compare_all_algorithms(text2, pattern2);
-    
-    // Test 3: Overlapping patterns
-    printf("\n\n--- Test 3: Overlapping Pattern ---\n");
-    const char *text3 = "AAAAAAAAAA";
-    const char *pattern3 = "AAA";
-    compare_all_algorithms(text3, pattern3);
-    
-    // Test 4: No match
-    printf("\n\n--- Test 4: No Match ---\n");
-    const char *text4 = "ACGTACGTACGT";
-    const char *pattern4 = "TTT";
-    compare_all_algorithms(text4, pattern4);
-    
-    // Test 5: Approximate matching
-    printf("\n\n--- Test 5: Approximate Matching (Levenshtein) ---\n");
-    const char *text5 = "ACGTACGTTACGT";
-    const char *pattern5 = "ACGT";
-    printf("Text: %s\n", text5);
-    printf("Pattern: %s\n", pattern5);
-    printf("Max distance: 1\n");
-    
-    ApproximateMatchResult lev_result = levenshtein_search(text5, pattern5, 1);
-    print_approximate_match_result("Levenshtein Distance Search", &lev_result);
-    free_approximate_match_result(&lev_result);
-}
-
-// Helper to run benchmark mode
-void run_benchmark_mode(int algo_id, const char *filename, const char *pattern) {
-    DNASequence *seq = load_fasta_file(filename);
-    if (!seq) {
-        fprintf(stderr, "Error loading file\n");
-        return;
-    }
-
-    MatchResult result;
-    // Initialize result to avoid compiler warnings
-    result.time_taken = -1.0;
-    result.positions = NULL;
-    result.count = 0;
-
-    switch(algo_id) {
-        case 3: result = kmp_search(seq->sequence, pattern); break;
-        case 15: result = naive_search(seq->sequence, pattern); break;
-        case 4: result = boyer_moore_search(seq->sequence, pattern); break;
-        case 5: {
-             // Suffix tree: O(n²) construction + O(m) search
-             SuffixTree *st = create_suffix_tree(seq->sequence);
-             result = suffix_tree_search(st, pattern);
-             free_suffix_tree(st);
-             break;
-        }
-        case 6: result = shift_or_search(seq->sequence, pattern); break;
-        case 11: result = rabin_karp_search(seq->sequence, pattern); break;
-        case 12: result = z_algorithm_search(seq->sequence, pattern); break;
-        default: fprintf(stderr, "Unknown algorithm\n"); break;
-    }
-
-    if (result.time_taken >= 0) {
-        printf("%f\n", result.time_taken);
-        free_match_result(&result);
-    }
-    free_dna_sequence(seq);
-}
-
-int main(int argc, char *argv[]) {
-    // Check for benchmark mode
-    if (argc == 5 && strcmp(argv[1], "--benchmark") == 0) {
-        int algo_id = atoi(argv[2]);
-        run_benchmark_mode(algo_id, argv[3], argv[4]);
-        return 0;
-    }
-
-    DNASequence *sequence = NULL;
-    char pattern[256];
-    int choice;
-    
-    srand(time(NULL));
-    
-    while (1) {
-        print_menu();
-        if (scanf("%d", &choice) != 1) choice = -1;
-        getchar(); // Consume newline
-        
-        switch (choice) {
-            case 1: {
-                char filename[256];
-                char filepath[512];
-                printf("Enter FASTA filename: ");
-                if (scanf("%255s", filename) != 1) filename[0] = '\0';
-                getchar();
-                
-                // Try data/ directory first, then current directory
-                snprintf(filepath, sizeof(filepath), "data/%s", filename);
-                
-                if (sequence) {
-                    free_dna_sequence(sequence);
-                }
-                
-                sequence = load_fasta_file(filepath);
-                if (!sequence) {
-                    // Try without data/ prefix
-                    sequence = load_fasta_file(filename);
-                }
-                
-                if (!sequence) {
-                    printf("Failed to load sequence!\n");
-                    printf("Tip: File should be in 'data/' folder or current directory\n");
-                }
-                break;
-            }
-            
-            case 2: {
-                int length;
-                printf("Enter sequence length: ");
-                if (scanf("%d", &length) != 1) length = 0;
-                getchar();
-                
-                if (sequence) {
-                    free_dna_sequence(sequence);
-                }
-                
-                sequence = (DNASequence *)malloc(sizeof(DNASequence));
-                sequence->header = strdup("Random DNA Sequence");
-                sequence->sequence = generate_random_dna(length);
-                sequence->length = length;
-                
-                printf("Generated random DNA sequence of length %d\n", length);
-                printf("First 50 bases: %.50s\n", sequence->sequence);
-                break;
-            }
-            
-            case 3: {
-                if (!sequence) {
-                    printf("Please load a sequence first!\n");
-                    break;
-                }
-                
-                print_algorithm_info(3);
-                printf("Enter pattern to search: ");
-                if (scanf("%255s", pattern) != 1) pattern[0] = '\0';
-                getchar();
-                
-                MatchResult result = kmp_search(sequence->sequence, pattern);
-                print_match_result("KMP Algorithm", &result);
-                print_sequence_with_highlights(sequence->sequence, result.positions, result.count, strlen(pattern), 30);
-                
-                if (result.count > 0) {
-                    printf("\nVerification: %s\n", 
-                           verify_kmp_matches(sequence->sequence, pattern, &result) ? 
-                           "All matches correct" : "Error in matches");
-                }
-                
-                free_match_result(&result);
-                break;
-            }
-
-            case 15: {
-                if (!sequence) {
-                    printf("Please load a sequence first!\n");
-                    break;
-                }
-                
-                print_algorithm_info(15);
-                printf("Enter pattern to search: ");
-                if (scanf("%255s", pattern) != 1) pattern[0] = '\0';
-                getchar();
-                
-                MatchResult result = naive_search(sequence->sequence, pattern);
-                print_match_result("Naive Algorithm", &result);
-                print_sequence_with_highlights(sequence->sequence, result.positions, result.count, strlen(pattern), 30);
-                free_match_result(&result);
-                break;
-            }
-            
-            case 4: {
-                if (!sequence) {
-                    printf("Please load a sequence first!\n");
-                    break;
-                }
-                
-                print_algorithm_info(4);
-                printf("Enter pattern to search: ");
-                if (scanf("%255s", pattern) != 1) pattern[0] = '\0';
-                getchar();
-                
-                MatchResult result = boyer_moore_search(sequence->sequence, pattern);
-                print_match_result("Boyer-Moore Algorithm", &result);
-                print_sequence_with_highlights(sequence->sequence, result.positions, result.count, strlen(pattern), 30);
-                free_match_result(&result);
-                break;
-            }
-            
-            case 5: {
-                if (!sequence) {
-                    printf("Please load a sequence first!\n");
-                    break;
-                }
-                
-                print_algorithm_info(5);
-                printf("Enter pattern to search: ");
-                if (scanf("%255s", pattern) != 1) pattern[0] = '\0';
-                getchar();
-                
-                printf("Building Suffix Tree (this may take a moment)...\n");
-                clock_t start = clock();
-                SuffixTree *tree = create_suffix_tree(sequence->sequence);
-                clock_t end = clock();
-                printf("Construction time: %.3f ms\n", 
-                       ((double)(end - start)) / CLOCKS_PER_SEC * 1000.0);
-                
-                MatchResult result = suffix_tree_search(tree, pattern);
-                print_match_result("Suffix Tree Algorithm", &result);
-                print_sequence_with_highlights(sequence->sequence, result.positions, result.count, strlen(pattern), 30);
-                
-                free_suffix_tree(tree);
-                free_match_result(&result);
-                break;
-            }
-            
-            case 6: {
-                if (!sequence) {
-                    printf("Please load a sequence first!\n");
-                    break;
-                }
-                
-                print_algorithm_info(6);
-                printf("Enter pattern to search (max 64 chars): ");
-                if (scanf("%255s", pattern) != 1) pattern[0] = '\0';
-                getchar();
-                
-                MatchResult result = shift_or_search(sequence->sequence, pattern);
-                print_match_result("Shift-Or Algorithm", &result);
-                print_sequence_with_highlights(sequence->sequence, result.positions, result.count, strlen(pattern), 30);
-                free_match_result(&result);
-                break;
-            }
-            
-            case 7: {
-                if (!sequence) {
-                    printf("Please load a sequence first!\n");
-                    break;
-                }
-                
-                print_algorithm_info(7);
-                printf("Enter pattern to search: ");
-                if (scanf("%255s", pattern) != 1) pattern[0] = '\0';
-                getchar();
-                
-                int max_dist;
-                printf("Enter maximum edit distance: ");
-                if (scanf("%d", &max_dist) != 1) max_dist = 1;
-                getchar();
-                
-                ApproximateMatchResult result = levenshtein_search(
-                    sequence->sequence, pattern, max_dist);
-                print_approximate_match_result("Levenshtein Distance Search", &result);
-                free_approximate_match_result(&result);
-                break;
-            }
-
-            case 8: {
-                if (!sequence) {
-                    printf("Please load a sequence first!\n");
-                    break;
-                }
-                
-                printf("Enter pattern to search: ");
-                if (scanf("%255s", pattern) != 1) pattern[0] = '\0';
-                getchar();
-                
-                compare_all_algorithms(sequence->sequence, pattern);
-                break;
-            }
-            
-            case 9: {
-                if (!sequence) {
-                    printf("Please load a sequence first!\n");
-                    break;
-                }
-
-                printf("Enter pattern to search: ");
-                if (scanf("%255s", pattern) != 1) pattern[0] = '\0';
-                getchar();
-
-                printf("\n=== Benchmark: KMP vs Python regex ===\n");
-
-                MatchResult kmp = kmp_search(sequence->sequence, pattern);
-                printf("\nKMP Algorithm:\n");
-                printf("  Matches: %d\n", kmp.count);
-                printf("  Time: %.3f ms\n", kmp.time_taken);
-
-                /* Write sequence and pattern to temp files for the Python script */
-                const char *text_tmp = "/tmp/aad_seq.txt";
-                const char *pat_tmp = "/tmp/aad_pat.txt";
-                FILE *ft = fopen(text_tmp, "w");
-                FILE *fp = fopen(pat_tmp, "w");
-                if (!ft || !fp) {
-                    printf("Failed to create temporary files for python benchmark\n");
-                } else {
-                    fprintf(ft, "%s", sequence->sequence);
-                    fprintf(fp, "%s", pattern);
-                    fclose(ft);
-                    fclose(fp);
-
-                    char cmd[512];
-                    snprintf(cmd, sizeof(cmd), "python3 bench/python_regex_bench.py %s %s", text_tmp, pat_tmp);
-                    FILE *pipe = popen(cmd, "r");
-                    if (!pipe) {
-                        printf("Failed to run python benchmark\n");
-                    } else {
-                        int py_count = 0;
-                        double py_time = 0.0;
-                        if (fscanf(pipe, "%d %lf", &py_count, &py_time) == 2) {
-                            printf("\nPython regex:\n");
-                            printf("  Matches: %d\n", py_count);
-                            printf("  Time: %.3f ms\n", py_time);
-
-                            if (kmp.time_taken > 0.0 && py_time > 0.0) {
-                                if (kmp.time_taken < py_time) {
-                                    printf("\n[+] KMP is %.2fx faster than Python regex\n", py_time / kmp.time_taken);
-                                } else {
-                                    printf("\n[+] Python regex is %.2fx faster than KMP\n", kmp.time_taken / py_time);
-                                }
-                            }
-                        } else {
-                            printf("Python benchmark produced no output\n");
-                        }
-                        pclose(pipe);
-                    }
-                }
-
-                free_match_result(&kmp);
-                break;
-            }
-            
-            case 10: {
-                run_comprehensive_tests();
-                break;
-            }
-            
-            case 11: {
-                if (!sequence) {
-                    printf("Please load a sequence first!\n");
-                    break;
-                }
-                
-                print_algorithm_info(11);
-                printf("Enter pattern to search: ");
-                if (scanf("%255s", pattern) != 1) pattern[0] = '\0';
-                getchar();
-                
-                MatchResult result = rabin_karp_search(sequence->sequence, pattern);
-                print_match_result("Rabin-Karp Algorithm (Rolling Hash)", &result);
-                print_sequence_with_highlights(sequence->sequence, result.positions, result.count, strlen(pattern), 30);
-                free_match_result(&result);
-                break;
-            }
-            
-            case 12: {
-                if (!sequence) {
-                    printf("Please load a sequence first!\n");
-                    break;
-                }
-                
-                print_algorithm_info(12);
-                printf("Enter pattern to search: ");
-                if (scanf("%255s", pattern) != 1) pattern[0] = '\0';
-                getchar();
-                
-                MatchResult result = z_algorithm_search(sequence->sequence, pattern);
-                print_match_result("Z-Algorithm", &result);
-                print_sequence_with_highlights(sequence->sequence, result.positions, result.count, strlen(pattern), 30);
-                free_match_result(&result);
-                break;
-            }
-            
-            case 13: {
-                if (!sequence) {
-                    printf("Please load a sequence first!\n");
-                    break;
-                }
-                
-                print_algorithm_info(13);
-                printf("\n=== Aho-Corasick Multiple Pattern Matching ===\n");
-                printf("Enter number of patterns (max 10): ");
-                int num_patterns;
-                if (scanf("%d", &num_patterns) != 1) num_patterns = 0;
-                getchar();
-                
-                if (num_patterns <= 0 || num_patterns > 10) {
-                    printf("Invalid number of patterns!\n");
-                    break;
-                }
-                
-                char **patterns = (char **)malloc(num_patterns * sizeof(char *));
-                for (int i = 0; i < num_patterns; i++) {
-                    patterns[i] = (char *)malloc(256 * sizeof(char));
-                    printf("Enter pattern %d: ", i + 1);
-                    if (scanf("%255s", patterns[i]) != 1) patterns[i][0] = '\0';
-                    getchar();
-                }
-                
-                MultiPatternResult result = aho_corasick_search(sequence->sequence, 
-                                                                (const char **)patterns, 
-                                                                num_patterns);
-                print_multi_pattern_result("Aho-Corasick Algorithm", &result, 
-                                          (const char **)patterns);
-                
-                free_multi_pattern_result(&result);
-                for (int i = 0; i < num_patterns; i++) {
-                    free(patterns[i]);
-                }
-                free(patterns);
-                break;
-            }
-            
-            case 0: {
-                if (sequence) {
-                    free_dna_sequence(sequence);
-                }
-                printf("\nThank you for using DNA Pattern Matching Suite!\n");
-                return 0;
-            }
-            
-            default:
-                printf("Invalid choice! Please try again.\n");
-        }
-    }
-    
-    return 0;
+/*
+ * Main Program - DNA Pattern Matching Suite
+ * Implements and benchmarks multiple pattern matching algorithms
+ */
+
+#define _GNU_SOURCE
+#include "pattern_matching.h"
+#include <regex.h>
+
+void print_algorithm_info(int choice) {
+    printf("\n[INFO] \033[1;34mAlgorithm Explanation:\033[0m\n");
+    switch(choice) {
+        case 3: // KMP
+            printf("   \033[1mKnuth-Morris-Pratt (KMP)\033[0m is an efficient exact matching algorithm.\n");
+            printf("   It preprocesses the pattern to create a 'Longest Prefix Suffix' (LPS) array.\n");
+            printf("   This allows it to skip unnecessary comparisons when a mismatch occurs, ensuring\n");
+            printf("   we never go backwards in the text. Time Complexity: O(n+m).\n");
+            break;
+        case 15: // Naive
+            printf("   \033[1mNaive (Brute Force)\033[0m is the simplest pattern matching algorithm.\n");
+            printf("   It checks for the pattern at every possible position in the text.\n");
+            printf("   Useful for verifying the correctness of more complex algorithms.\n");
+            printf("   Time Complexity: O(nm).\n");
+            break;
+        case 4: // Boyer-Moore
+            printf("   \033[1mBoyer-Moore\033[0m is often the fastest algorithm for standard text.\n");
+            printf("   It scans the pattern from right to left and uses two heuristics (Bad Character\n");
+            printf("   and Good Suffix) to skip large chunks of text when a mismatch is found.\n");
+            printf("   Time Complexity: Average O(n/m), Worst O(nm).\n");
+            break;
+        case 5: // Suffix Tree
+            printf("   \033[1mSuffix Tree\033[0m is a compressed trie of all text suffixes.\n");
+            printf("   It builds an explicit tree structure with '$' terminator ensuring unique leaves.\n");
+            printf("   Construction: O(n) via Ukkonen's online algorithm. Search: O(m) tree walk.\n");
+            printf("   Ideal for multiple pattern queries on the same text after preprocessing.\n");
+            break;
+        case 6: // Shift-Or
+            printf("   \033[1mShift-Or (Bitap)\033[0m uses bitwise operations to simulate a non-deterministic automaton.\n");
+            printf("   It is extremely fast because it processes the text with branch-free word operations;\n");
+            printf("   patterns longer than 64 chars use a blocked multi-word state with carry\n");
+            printf("   propagation. Time Complexity: O(n * m/64).\n");
+            break;
+        case 11: // Rabin-Karp
+            printf("   \033[1mRabin-Karp\033[0m uses hashing.\n");
+            printf("   It calculates a 'fingerprint' (hash) for the pattern and for every window of text.\n");
+            printf("   If hashes match, it checks the characters. It uses a 'rolling hash' to update\n");
+            printf("   the hash value quickly as it moves through the text.\n");
+            break;
+        case 12: // Z-Algorithm
+            printf("   \033[1mZ-Algorithm\033[0m computes a 'Z-array'.\n");
+            printf("   For every position in the text, it calculates the length of the longest substring\n");
+            printf("   starting there that matches the prefix of the string. It's a fundamental linear-time method.\n");
+            break;
+        case 7: // Levenshtein
+            printf("   \033[1mLevenshtein Distance\033[0m finds 'fuzzy' matches.\n");
+            printf("   It allows for errors (insertions, deletions, substitutions). We search for substrings\n");
+            printf("   in the text that are within a specific 'edit distance' from your pattern.\n");
+            break;
+        case 14: // FM-Index
+            printf("   \033[1mFM-Index\033[0m is a compressed full-text index built on the Burrows-Wheeler transform.\n");
+            printf("   It answers queries via 'backward search' over the BWT in O(m) steps, using only\n");
+            printf("   about 1.5 bytes of index per text character - far less than a suffix tree.\n");
+            printf("   Like the suffix tree, build once and query many times on the same text.\n");
+            break;
+        case 20: // Myers Bit-Parallel
+            printf("   \033[1mMyers Bit-Parallel\033[0m is a fast approximate (fuzzy) matcher.\n");
+            printf("   It packs a whole column of the edit-distance matrix into machine words and\n");
+            printf("   updates all of it with a few bit operations per text character - scanning the\n");
+            printf("   entire text in O(n * m/64) with no per-window work, unlike the plain DP search.\n");
+            break;
+        case 13: // Aho-Corasick
+            printf("   \033[1mAho-Corasick\033[0m is designed for finding *multiple* patterns at once.\n");
+            printf("   It builds a finite automaton (Trie) of all patterns with 'failure links'.\n");
+            printf("   It scans the text once and tells us whenever *any* of the patterns are found.\n");
+            break;
+    }
+    printf("   ---------------------------------------------------------\n");
+}
+
+void print_menu() {
+    printf("\n+========================================================+\n");
+    printf("|   DNA Pattern Matching Algorithm Suite (8 Algorithms)  |\n");
+    printf("+========================================================+\n");
+    printf("\n=== Exact Matching Algorithms ===\n");
+    printf("3. Run KMP Algorithm\n");
+    printf("15. Run Naive (Brute Force) Algorithm\n");
+    printf("4. Run Boyer-Moore Algorithm\n");
+    printf("5. Run Suffix Tree Algorithm\n");
+    printf("6. Run Shift-Or Algorithm\n");
+    printf("11. Run Rabin-Karp Algorithm (Rolling Hash)\n");
+    printf("12. Run Z-Algorithm\n");
+    printf("14. Run FM-Index Search (BWT-based)\n");
+    printf("16. Load saved FM-Index from disk and search\n");
+    printf("22. Run k-mer Seed Index Search (build once, query fast)\n");
+    printf("23. Count-Only / Sampled Search (no full position array)\n");
+    printf("25. Auto-Select Search (calibrated per-machine dispatch)\n");
+    printf("26. Suffix Tree Probe Panel (batched multi-pattern queries)\n");
+    printf("27. Incremental Z Search (append-only growing sequence)\n");
+    printf("\n=== Approximate/Multi-Pattern Matching ===\n");
+    printf("7. Run Levenshtein Distance Search (Approximate)\n");
+    printf("20. Run Myers Bit-Parallel Search (Approximate, fast)\n");
+    printf("13. Run Aho-Corasick (Multiple Pattern Matching)\n");
+    printf("17. Run Parallel Chunked Search (multi-threaded)\n");
+    printf("18. Run 2-bit Packed Search (ACGT-only sequences)\n");
+    printf("19. Stream-search a FASTA file (larger than RAM)\n");
+    printf("24. Pipelined stream-search (reader thread + search thread)\n");
+    printf("21. Search a multi-record FASTA file (per-record parallel)\n");
+    printf("\n=== Benchmarking & Testing ===\n");
+    printf("8. Compare all algorithms (Exact Match)\n");
+    printf("9. Benchmark with Python regex comparison\n");
+    printf("10. Run comprehensive test suite\n");
+    printf("\n=== Data Management ===\n");
+    printf("1. Load DNA sequence from FASTA file\n");
+    printf("2. Generate random DNA sequence\n");
+    printf("\n0. Exit\n");
+    printf("\nEnter your choice: ");
+}
+
+MatchResult regex_search(const char *text, const char *pattern) {
+    MatchResult result;
+    init_match_result(&result);
+    
+    clock_t start = clock();
+    
+    regex_t regex;
+    regmatch_t match;
+    
+    if (regcomp(&regex, pattern, REG_EXTENDED) != 0) {
+        fprintf(stderr, "Failed to compile regex\n");
+        return result;
+    }
+    
+    int capacity = 100;
+    int *matches = (int *)malloc(capacity * sizeof(int));
+    int count = 0;
+    
+    const char *p = text;
+    int offset = 0;
+    
+    while (regexec(&regex, p, 1, &match, 0) == 0) {
+        if (count >= capacity) {
+            capacity *= 2;
+            int *temp = (int *)realloc(matches, capacity * sizeof(int));
+            if (!temp) {
+                free(matches);
+                regfree(&regex);
+                return result;
+            }
+            matches = temp;
+        }
+        
+        matches[count++] = offset + match.rm_so;
+        p += match.rm_so + 1;
+        offset += match.rm_so + 1;
+    }
+    
+    regfree(&regex);
+    
+    clock_t end = clock();
+    
+    result.positions = matches;
+    result.count = count;
+    result.time_taken = ((double)(end - start)) / CLOCKS_PER_SEC * 1000.0;
+    
+    return result;
+}
+
+void compare_all_algorithms(const char *text, const char *pattern) {
+    printf("\n+====================================================================+\n");
+    printf("|        [COMP] Comparing All Exact Matching Algorithms        |\n");
+    printf("+====================================================================+\n");
+    printf("\n  [LEN ] Text length: %zu\n", strlen(text));
+    printf("  [LEN ] Pattern length: %zu\n", strlen(pattern));
+    printf("  [PATT] Pattern: %s\n", pattern);
+    
+    // Naive
+    MatchResult naive_result = naive_search(text, pattern);
+    print_match_result("Naive Algorithm", &naive_result);
+
+    // KMP
+    MatchResult kmp_result = kmp_search(text, pattern);
+    print_match_result("KMP Algorithm", &kmp_result);
+    
+    // Boyer-Moore
+    MatchResult bm_result = boyer_moore_search(text, pattern);
+    print_match_result("Boyer-Moore Algorithm", &bm_result);
+    
+    // Suffix Tree
+    printf("\n[TREE] Building Suffix Tree...\n");
+    clock_t st_start = clock();
+    SuffixTree *tree = create_suffix_tree(text);
+    clock_t st_end = clock();
+    double construction_time = ((double)(st_end - st_start)) / CLOCKS_PER_SEC * 1000.0;
+    printf("   Construction time: %.3f ms\n", construction_time);
+    
+    MatchResult st_result = suffix_tree_search(tree, pattern);
+    print_match_result("Suffix Tree Algorithm", &st_result);
+    free_suffix_tree(tree);
+    
+    // Shift-Or (single word up to 64 chars, blocked multi-word beyond)
+    MatchResult so_result = shift_or_search(text, pattern);
+    print_match_result("Shift-Or Algorithm", &so_result);
+
+    // Rabin-Karp
+    MatchResult rk_result = rabin_karp_search(text, pattern);
+    print_match_result("Rabin-Karp Algorithm", &rk_result);
+    
+    // Z-Algorithm
+    MatchResult z_result = z_algorithm_search(text, pattern);
+    print_match_result("Z-Algorithm", &z_result);
+
+    // SIMD rare-byte prefilter (kernel picked at runtime)
+    MatchResult simd_result = simd_search(text, pattern);
+    print_match_result("SIMD Prefilter", &simd_result);
+
+    // Parallel driver: Boyer-Moore across all online CPUs
+    MatchResult par_result = parallel_search(SEARCH_ALGO_BOYER_MOORE, text,
+                                             strlen(text), pattern, 0);
+    print_match_result("Parallel Boyer-Moore", &par_result);
+
+    // Verify correctness
+    printf("\n+----------------------------------+\n");
+    printf("|  [ OK ] Correctness Verification |\n");
+    printf("+----------------------------------+\n");
+    printf("  Naive matches verified: %s\n", 
+           (naive_result.count == kmp_result.count) ? "[ OK ] YES" : "[FAIL] NO");
+    
+    int all_match = (naive_result.count == kmp_result.count &&
+                     kmp_result.count == bm_result.count && 
+                     bm_result.count == st_result.count &&
+                     st_result.count == so_result.count &&
+                     so_result.count == rk_result.count &&
+                     rk_result.count == z_result.count &&
+                     z_result.count == simd_result.count &&
+                     simd_result.count == par_result.count);
+    printf("  All algorithms agree: %s\n", all_match ? "[ OK ] YES" : "[WARN]  NO");
+    
+    // Summary comparison
+    printf("\n+----------------------------------------------------------------------+\n");
+    printf("|        [STAT] Performance Summary (All Algorithms)          |\n");
+    printf("+----------------------------------------------------------------------+\n\n");
+    printf("  %-20s | %10s | %15s | %15s\n", "Algorithm", "Matches", "Time (ms)", "Memory (bytes)");
+    printf("  ---------------------------------------------------------------\n");
+    printf("  %-20s | %10d | %15.3f | %15zu\n", "Naive", naive_result.count, 
+           naive_result.time_taken, naive_result.memory_used);
+    printf("  %-20s | %10d | %15.3f | %15zu\n", "KMP", kmp_result.count, 
+           kmp_result.time_taken, kmp_result.memory_used);
+    printf("  %-20s | %10d | %15.3f | %15zu\n", "Boyer-Moore", bm_result.count,
+           bm_result.time_taken, bm_result.memory_used);
+    printf("  %-20s | %10d | %15.3f | %15zu\n", "Suffix Tree", st_result.count,
+           st_result.time_taken, st_result.memory_used);
+    printf("  %-20s | %10d | %15.3f | %15zu\n", "Shift-Or", so_result.count,
+           so_result.time_taken, so_result.memory_used);
+    printf("  %-20s | %10d | %15.3f | %15zu\n", "Rabin-Karp", rk_result.count,
+           rk_result.time_taken, rk_result.memory_used);
+    printf("  %-20s | %10d | %15.3f | %15zu\n", "Z-Algorithm", z_result.count,
+           z_result.time_taken, z_result.memory_used);
+    printf("  %-20s | %10d | %15.3f | %15zu\n", "SIMD Prefilter", simd_result.count,
+           simd_result.time_taken, simd_result.memory_used);
+    printf("  %-20s | %10d | %15.3f | %15zu\n", "Parallel BM", par_result.count,
+           par_result.time_taken, par_result.memory_used);
+
+    // Find fastest
+    double min_time = naive_result.time_taken;
+    const char *fastest = "Naive";
+
+    if (kmp_result.time_taken < min_time) {
+        min_time = kmp_result.time_taken;
+        fastest = "KMP";
+    }
+    
+    if (bm_result.time_taken < min_time) {
+        min_time = bm_result.time_taken;
+        fastest = "Boyer-Moore";
+    }
+    if (st_result.time_taken < min_time) {
+        min_time = st_result.time_taken;
+        fastest = "Suffix Tree";
+    }
+    if (so_result.time_taken < min_time) {
+        min_time = so_result.time_taken;
+        fastest = "Shift-Or";
+    }
+    if (rk_result.time_taken < min_time) {
+        min_time = rk_result.time_taken;
+        fastest = "Rabin-Karp";
+    }
+    if (z_result.time_taken < min_time) {
+        min_time = z_result.time_taken;
+        fastest = "Z-Algorithm";
+    }
+    if (simd_result.time_taken < min_time) {
+        min_time = simd_result.time_taken;
+        fastest = "SIMD Prefilter";
+    }
+    if (par_result.time_taken < min_time) {
+        min_time = par_result.time_taken;
+        fastest = "Parallel BM";
+    }
+
+    printf("\n  [BEST] Fastest algorithm: %s (%.3f ms)\n", fastest, min_time);
+    
+    // Cleanup
+    free_match_result(&naive_result);
+    free_match_result(&kmp_result);
+    free_match_result(&bm_result);
+    free_match_result(&st_result);
+    free_match_result(&so_result);
+    free_match_result(&rk_result);
+    free_match_result(&z_result);
+    free_match_result(&simd_result);
+    free_match_result(&par_result);
+}
+
+// Dual-strand comparison: every dispatchable matcher searches pattern and
+// reverse complement together, and the strand-tagged counts must agree
+void compare_all_algorithms_dual(const char *text, const char *pattern) {
+    struct {
+        const char *name;
+        SearchAlgorithm algo;
+    } algos[] = {
+        { "Naive (dual)",       SEARCH_ALGO_NAIVE },
+        { "KMP (dual)",         SEARCH_ALGO_KMP },
+        { "Boyer-Moore (dual)", SEARCH_ALGO_BOYER_MOORE },
+        { "Rabin-Karp (dual)",  SEARCH_ALGO_RABIN_KARP },
+        { "Z-Algorithm (dual)", SEARCH_ALGO_Z },
+        { "Shift-Or (dual)",    SEARCH_ALGO_SHIFT_OR },
+    };
+    int num_algos = (int)(sizeof(algos) / sizeof(algos[0]));
+
+    char *rev = reverse_complement(pattern);
+    printf("\n+====================================================================+\n");
+    printf("|        [COMP] Dual-Strand Comparison (Both Strands)          |\n");
+    printf("+====================================================================+\n");
+    printf("\n  [PATT] Forward pattern: %s\n", pattern);
+    printf("  [PATT] Reverse complement: %s\n", rev ? rev : "(allocation failed)");
+    free(rev);
+
+    int first_count = -1;
+    int all_match = 1;
+    double min_time = 0.0;
+    const char *fastest = NULL;
+
+    printf("\n  %-20s | %10s | %10s | %10s | %12s\n",
+           "Algorithm", "Matches", "Forward", "Reverse", "Time (ms)");
+    printf("  ------------------------------------------------------------------------\n");
+
+    for (int i = 0; i < num_algos; i++) {
+        StrandMatchResult ds = dual_strand_search(algos[i].algo, text, pattern);
+
+        int fwd = 0, rc = 0;
+        for (int j = 0; j < ds.count; j++) {
+            if (ds.strands[j] == '+') fwd++;
+            else rc++;
+        }
+        printf("  %-20s | %10d | %10d | %10d | %12.3f\n",
+               algos[i].name, ds.count, fwd, rc, ds.time_taken);
+
+        if (first_count < 0) first_count = ds.count;
+        else if (ds.count != first_count) all_match = 0;
+
+        if (!fastest || ds.time_taken < min_time) {
+            min_time = ds.time_taken;
+            fastest = algos[i].name;
+        }
+        free_strand_match_result(&ds);
+    }
+
+    printf("\n  All algorithms agree: %s\n", all_match ? "[ OK ] YES" : "[WARN]  NO");
+    if (fastest) {
+        printf("  [BEST] Fastest algorithm: %s (%.3f ms)\n", fastest, min_time);
+    }
+}
+
+void run_comprehensive_tests() {
+    printf("\n+========================================================+\n");
+    printf("|           Comprehensive Test Suite                     |\n");
+    printf("+========================================================+\n");
+    
+    // Test 1: Simple pattern
+    printf("\n--- Test 1: Simple Pattern ---\n");
+    const char *text1 = "ACGTACGTACGT";
+    const char *pattern1 = "ACG";
+    compare_all_algorithms(text1, pattern1);
+    
+    // Test 2: Non-overlapping patterns
+    printf("\n\n--- Test 2: Non-overlapping Pattern ---\n");
+    const char *text2 = "AAAACAAAACAAAAC";
+    const char *pattern2 = "AAAC";
+    compare_all_algorithms(text2, pattern2);
+    
+    // Test 3: Overlapping patterns
+    printf("\n\n--- Test 3: Overlapping Pattern ---\n");
+    const char *text3 = "AAAAAAAAAA";
+    const char *pattern3 = "AAA";
+    compare_all_algorithms(text3, pattern3);
+    
+    // Test 4: No match
+    printf("\n\n--- Test 4: No Match ---\n");
+    const char *text4 = "ACGTACGTACGT";
+    const char *pattern4 = "TTT";
+    compare_all_algorithms(text4, pattern4);
+    
+    // Test 5: Approximate matching
+    printf("\n\n--- Test 5: Approximate Matching (Levenshtein) ---\n");
+    const char *text5 = "ACGTACGTTACGT";
+    const char *pattern5 = "ACGT";
+    printf("Text: %s\n", text5);
+    printf("Pattern: %s\n", pattern5);
+    printf("Max distance: 1\n");
+    
+    ApproximateMatchResult lev_result = levenshtein_search(text5, pattern5, 1);
+    print_approximate_match_result("Levenshtein Distance Search", &lev_result);
+    free_approximate_match_result(&lev_result);
+}
+
+// Helper to run benchmark mode
+void run_benchmark_mode(int algo_id, const char *filename, const char *pattern) {
+    DNASequence *seq = load_fasta_file_mmap(filename);
+    if (!seq) seq = load_fasta_file(filename);
+    if (!seq) {
+        fprintf(stderr, "Error loading file\n");
+        return;
+    }
+
+    MatchResult result;
+    // Initialize result to avoid compiler warnings
+    init_match_result(&result);
+    result.time_taken = -1.0;
+
+    switch(algo_id) {
+        case 3: result = kmp_search(seq->sequence, pattern); break;
+        case 15: result = naive_search(seq->sequence, pattern); break;
+        case 4: result = boyer_moore_search(seq->sequence, pattern); break;
+        case 5: {
+             // Suffix tree: O(n) Ukkonen construction + O(m) search
+             SuffixTree *st = create_suffix_tree(seq->sequence);
+             result = suffix_tree_search(st, pattern);
+             free_suffix_tree(st);
+             break;
+        }
+        case 6: result = shift_or_search(seq->sequence, pattern); break;
+        case 14: {
+             // FM-index: build + O(m) backward search
+             FMIndex *fm = create_fm_index(seq->sequence);
+             result = fm_index_search(fm, pattern);
+             free_fm_index(fm);
+             break;
+        }
+        case 11: result = rabin_karp_search(seq->sequence, pattern); break;
+        case 12: result = z_algorithm_search(seq->sequence, pattern); break;
+        default: fprintf(stderr, "Unknown algorithm\n"); break;
+    }
+
+    if (result.time_taken >= 0) {
+        printf("%f\n", result.time_taken);
+        free_match_result(&result);
+    }
+    free_dna_sequence(seq);
+}
+
+// Batch mode: load the sequence once, run every pattern from a file,
+// emit TSV (pattern, matches, time_ms, comma-separated positions).
+// Index-based algorithms build their index once and reuse it for all
+// patterns; table-based algorithms go through the compiled-pattern API.
+int run_batch_mode(const char *algo_name, const char *fasta, const char *patterns_file) {
+    int use_compiled = 0;
+    SearchAlgorithm compiled_algo = SEARCH_ALGO_KMP;
+
+    if (strcmp(algo_name, "naive") == 0) { use_compiled = 1; compiled_algo = SEARCH_ALGO_NAIVE; }
+    else if (strcmp(algo_name, "kmp") == 0) { use_compiled = 1; compiled_algo = SEARCH_ALGO_KMP; }
+    else if (strcmp(algo_name, "boyer_moore") == 0) { use_compiled = 1; compiled_algo = SEARCH_ALGO_BOYER_MOORE; }
+    else if (strcmp(algo_name, "rabin_karp") == 0) { use_compiled = 1; compiled_algo = SEARCH_ALGO_RABIN_KARP; }
+    else if (strcmp(algo_name, "shift_or") == 0) { use_compiled = 1; compiled_algo = SEARCH_ALGO_SHIFT_OR; }
+    else if (strcmp(algo_name, "z") != 0 && strcmp(algo_name, "simd") != 0 &&
+             strcmp(algo_name, "parallel") != 0 && strcmp(algo_name, "suffix_tree") != 0 &&
+             strcmp(algo_name, "fm_index") != 0) {
+        fprintf(stderr, "Unknown algorithm '%s'. Choose from: naive kmp boyer_moore "
+                        "rabin_karp shift_or z simd parallel suffix_tree fm_index\n",
+                algo_name);
+        return 1;
+    }
+
+    DNASequence *seq = load_fasta_file_mmap(fasta);
+    if (!seq) seq = load_fasta_file(fasta);
+    if (!seq) {
+        fprintf(stderr, "Error loading %s\n", fasta);
+        return 1;
+    }
+
+    FILE *pf = fopen(patterns_file, "r");
+    if (!pf) {
+        fprintf(stderr, "Error: Cannot open pattern file %s\n", patterns_file);
+        free_dna_sequence(seq);
+        return 1;
+    }
+
+    // One-time index construction, amortized over every pattern below
+    SuffixTree *tree = NULL;
+    FMIndex *fm = NULL;
+    if (strcmp(algo_name, "suffix_tree") == 0) {
+        tree = create_suffix_tree(seq->sequence);
+        if (!tree) { fclose(pf); free_dna_sequence(seq); return 1; }
+    } else if (strcmp(algo_name, "fm_index") == 0) {
+        fm = create_fm_index(seq->sequence);
+        if (!fm) { fclose(pf); free_dna_sequence(seq); return 1; }
+    }
+
+    printf("pattern\tmatches\ttime_ms\tpositions\n");
+
+    char *line = NULL;
+    size_t line_cap = 0;
+    ssize_t line_len;
+    int failures = 0;
+
+    while ((line_len = getline(&line, &line_cap, pf)) != -1) {
+        while (line_len > 0 && (line[line_len - 1] == '\n' || line[line_len - 1] == '\r'))
+            line[--line_len] = '\0';
+        if (line_len == 0 || line[0] == '#') continue;
+
+        MatchResult result;
+        init_match_result(&result);
+
+        if (use_compiled) {
+            CompiledPattern *handle = compile_pattern(line, compiled_algo);
+            if (!handle) {
+                fprintf(stderr, "Skipping pattern '%s' (compile failed)\n", line);
+                failures++;
+                continue;
+            }
+            result = search_compiled(handle, seq->sequence, seq->length);
+            free_compiled_pattern(handle);
+        } else if (tree) {
+            result = suffix_tree_search(tree, line);
+        } else if (fm) {
+            result = fm_index_search(fm, line);
+        } else if (strcmp(algo_name, "z") == 0) {
+            result = z_algorithm_search(seq->sequence, line);
+        } else if (strcmp(algo_name, "simd") == 0) {
+            result = simd_search(seq->sequence, line);
+        } else {
+            result = parallel_search(SEARCH_ALGO_BOYER_MOORE, seq->sequence,
+                                     seq->length, line, 0);
+        }
+
+        printf("%s\t%d\t%.4f\t", line, result.count, result.time_taken);
+        for (int i = 0; i < result.count; i++) {
+            printf("%s%d", (i > 0) ? "," : "", result.positions[i]);
+        }
+        printf("\n");
+        free_match_result(&result);
+    }
+
+    free(line);
+    fclose(pf);
+    if (tree) free_suffix_tree(tree);
+    if (fm) free_fm_index(fm);
+    free_dna_sequence(seq);
+    return (failures > 0) ? 1 : 0;
+}
+
+int main(int argc, char *argv[]) {
+    // Check for benchmark mode
+    if (argc == 5 && strcmp(argv[1], "--benchmark") == 0) {
+        int algo_id = atoi(argv[2]);
+        run_benchmark_mode(algo_id, argv[3], argv[4]);
+        return 0;
+    }
+
+    // Check for batch mode: --search <algo> <fasta> --patterns <file>
+    if (argc == 6 && strcmp(argv[1], "--search") == 0 && strcmp(argv[4], "--patterns") == 0) {
+        return run_batch_mode(argv[2], argv[3], argv[5]);
+    }
+    if (argc > 1 && strcmp(argv[1], "--search") == 0) {
+        fprintf(stderr, "Usage: %s --search <algo> <fasta> --patterns <file>\n", argv[0]);
+        return 1;
+    }
+
+    DNASequence *sequence = NULL;
+    char pattern[256];
+    int choice;
+    
+    srand(time(NULL));
+    
+    while (1) {
+        print_menu();
+        if (scanf("%d", &choice) != 1) choice = -1;
+        getchar(); // Consume newline
+        
+        switch (choice) {
+            case 1: {
+                char filename[256];
+                char filepath[512];
+                printf("Enter FASTA filename: ");
+                if (scanf("%255s", filename) != 1) filename[0] = '\0';
+                getchar();
+                
+                // Try data/ directory first, then current directory
+                snprintf(filepath, sizeof(filepath), "data/%s", filename);
+                
+                if (sequence) {
+                    free_dna_sequence(sequence);
+                }
+                
+                // Prefer the mmap loader (single pass, no realloc doubling);
+                // fall back to the getline loader if mmap is unavailable
+                sequence = load_fasta_file_mmap(filepath);
+                if (!sequence) {
+                    sequence = load_fasta_file(filepath);
+                }
+                if (!sequence) {
+                    // Try without data/ prefix
+                    sequence = load_fasta_file_mmap(filename);
+                }
+                if (!sequence) {
+                    sequence = load_fasta_file(filename);
+                }
+                
+                if (!sequence) {
+                    printf("Failed to load sequence!\n");
+                    printf("Tip: File should be in 'data/' folder or current directory\n");
+                }
+                break;
+            }
+            
+            case 2: {
+                int length;
+                printf("Enter sequence length: ");
+                if (scanf("%d", &length) != 1) length = 0;
+                getchar();
+                
+                if (sequence) {
+                    free_dna_sequence(sequence);
+                }
+                
+                sequence = (DNASequence *)malloc(sizeof(DNASequence));
+                sequence->header = strdup("Random DNA Sequence");
+                sequence->sequence = generate_random_dna(length);
+                sequence->length = length;
+                
+                printf("Generated random DNA sequence of length %d\n", length);
+                printf("First 50 bases: %.50s\n", sequence->sequence);
+                break;
+            }
+            
+            case 3: {
+                if (!sequence) {
+                    printf("Please load a sequence first!\n");
+                    break;
+                }
+                
+                print_algorithm_info(3);
+                printf("Enter pattern to search: ");
+                if (scanf("%255s", pattern) != 1) pattern[0] = '\0';
+                getchar();
+
+                char strand_choice;
+                printf("Search both strands (pattern + reverse complement)? (y/n): ");
+                if (scanf(" %c", &strand_choice) != 1) strand_choice = 'n';
+                getchar();
+
+                if (strand_choice == 'y' || strand_choice == 'Y') {
+                    StrandMatchResult ds = dual_strand_search(SEARCH_ALGO_KMP,
+                                                              sequence->sequence, pattern);
+                    print_strand_match_result("KMP (dual-strand)", &ds);
+                    free_strand_match_result(&ds);
+                    break;
+                }
+
+                MatchResult result = kmp_search(sequence->sequence, pattern);
+                print_match_result("KMP Algorithm", &result);
+                print_sequence_with_highlights(sequence->sequence, result.positions, result.count, strlen(pattern), 30);
+                
+                if (result.count > 0) {
+                    printf("\nVerification: %s\n", 
+                           verify_kmp_matches(sequence->sequence, pattern, &result) ? 
+                           "All matches correct" : "Error in matches");
+                }
+                
+                free_match_result(&result);
+                break;
+            }
+
+            case 15: {
+                if (!sequence) {
+                    printf("Please load a sequence first!\n");
+                    break;
+                }
+                
+                print_algorithm_info(15);
+                printf("Enter pattern to search: ");
+                if (scanf("%255s", pattern) != 1) pattern[0] = '\0';
+                getchar();
+                
+                MatchResult result = naive_search(sequence->sequence, pattern);
+                print_match_result("Naive Algorithm", &result);
+                print_sequence_with_highlights(sequence->sequence, result.positions, result.count, strlen(pattern), 30);
+                free_match_result(&result);
+                break;
+            }
+            
+            case 4: {
+                if (!sequence) {
+                    printf("Please load a sequence first!\n");
+                    break;
+                }
+                
+                print_algorithm_info(4);
+                printf("Enter pattern to search: ");
+                if (scanf("%255s", pattern) != 1) pattern[0] = '\0';
+                getchar();
+
+                char strand_choice;
+                printf("Search both strands (pattern + reverse complement)? (y/n): ");
+                if (scanf(" %c", &strand_choice) != 1) strand_choice = 'n';
+                getchar();
+
+                if (strand_choice == 'y' || strand_choice == 'Y') {
+                    StrandMatchResult ds = dual_strand_search(SEARCH_ALGO_BOYER_MOORE,
+                                                              sequence->sequence, pattern);
+                    print_strand_match_result("Boyer-Moore (dual-strand)", &ds);
+                    free_strand_match_result(&ds);
+                    break;
+                }
+
+                MatchResult result = boyer_moore_search(sequence->sequence, pattern);
+                print_match_result("Boyer-Moore Algorithm", &result);
+                print_sequence_with_highlights(sequence->sequence, result.positions, result.count, strlen(pattern), 30);
+                free_match_result(&result);
+                break;
+            }
+            
+            case 5: {
+                if (!sequence) {
+                    printf("Please load a sequence first!\n");
+                    break;
+                }
+                
+                print_algorithm_info(5);
+                printf("Enter pattern to search: ");
+                if (scanf("%255s", pattern) != 1) pattern[0] = '\0';
+                getchar();
+                
+                printf("Building Suffix Tree (this may take a moment)...\n");
+                clock_t start = clock();
+                SuffixTree *tree = create_suffix_tree(sequence->sequence);
+                clock_t end = clock();
+                printf("Construction time: %.3f ms\n", 
+                       ((double)(end - start)) / CLOCKS_PER_SEC * 1000.0);
+                
+                MatchResult result = suffix_tree_search(tree, pattern);
+                print_match_result("Suffix Tree Algorithm", &result);
+                print_sequence_with_highlights(sequence->sequence, result.positions, result.count, strlen(pattern), 30);
+                
+                free_suffix_tree(tree);
+                free_match_result(&result);
+                break;
+            }
+            
+            case 6: {
+                if (!sequence) {
+                    printf("Please load a sequence first!\n");
+                    break;
+                }
+                
+                print_algorithm_info(6);
+                printf("Enter pattern to search: ");
+                if (scanf("%255s", pattern) != 1) pattern[0] = '\0';
+                getchar();
+
+                char strand_choice;
+                printf("Search both strands (pattern + reverse complement)? (y/n): ");
+                if (scanf(" %c", &strand_choice) != 1) strand_choice = 'n';
+                getchar();
+
+                if (strand_choice == 'y' || strand_choice == 'Y') {
+                    StrandMatchResult ds = dual_strand_search(SEARCH_ALGO_SHIFT_OR,
+                                                              sequence->sequence, pattern);
+                    print_strand_match_result("Shift-Or (dual-strand)", &ds);
+                    free_strand_match_result(&ds);
+                    break;
+                }
+
+                MatchResult result = shift_or_search(sequence->sequence, pattern);
+                print_match_result("Shift-Or Algorithm", &result);
+                print_sequence_with_highlights(sequence->sequence, result.positions, result.count, strlen(pattern), 30);
+                free_match_result(&result);
+                break;
+            }
+            
+            case 7: {
+                if (!sequence) {
+                    printf("Please load a sequence first!\n");
+                    break;
+                }
+                
+                print_algorithm_info(7);
+                printf("Enter pattern to search: ");
+                if (scanf("%255s", pattern) != 1) pattern[0] = '\0';
+                getchar();
+                
+                int max_dist;
+                printf("Enter maximum edit distance: ");
+                if (scanf("%d", &max_dist) != 1) max_dist = 1;
+                getchar();
+                
+                ApproximateMatchResult result = levenshtein_search(
+                    sequence->sequence, pattern, max_dist);
+                print_approximate_match_result("Levenshtein Distance Search", &result);
+                free_approximate_match_result(&result);
+                break;
+            }
+
+            case 8: {
+                if (!sequence) {
+                    printf("Please load a sequence first!\n");
+                    break;
+                }
+                
+                printf("Enter pattern to search: ");
+                if (scanf("%255s", pattern) != 1) pattern[0] = '\0';
+                getchar();
+
+                char strand_choice;
+                printf("Include reverse-complement strand? (y/n): ");
+                if (scanf(" %c", &strand_choice) != 1) strand_choice = 'n';
+                getchar();
+
+                compare_all_algorithms(sequence->sequence, pattern);
+                if (strand_choice == 'y' || strand_choice == 'Y') {
+                    compare_all_algorithms_dual(sequence->sequence, pattern);
+                }
+                break;
+            }
+            
+            case 9: {
+                if (!sequence) {
+                    printf("Please load a sequence first!\n");
+                    break;
+                }
+
+                printf("Enter pattern to search: ");
+                if (scanf("%255s", pattern) != 1) pattern[0] = '\0';
+                getchar();
+
+                printf("\n=== Benchmark: KMP vs Python regex ===\n");
+
+                MatchResult kmp = kmp_search(sequence->sequence, pattern);
+                printf("\nKMP Algorithm:\n");
+                printf("  Matches: %d\n", kmp.count);
+                printf("  Time: %.3f ms\n", kmp.time_taken);
+
+                /* Write sequence and pattern to temp files for the Python script */
+                const char *text_tmp = "/tmp/aad_seq.txt";
+                const char *pat_tmp = "/tmp/aad_pat.txt";
+                FILE *ft = fopen(text_tmp, "w");
+                FILE *fp = fopen(pat_tmp, "w");
+                if (!ft || !fp) {
+                    printf("Failed to create temporary files for python benchmark\n");
+                } else {
+                    fprintf(ft, "%s", sequence->sequence);
+                    fprintf(fp, "%s", pattern);
+                    fclose(ft);
+                    fclose(fp);
+
+                    char cmd[512];
+                    snprintf(cmd, sizeof(cmd), "python3 bench/python_regex_bench.py %s %s", text_tmp, pat_tmp);
+                    FILE *pipe = popen(cmd, "r");
+                    if (!pipe) {
+                        printf("Failed to run python benchmark\n");
+                    } else {
+                        int py_count = 0;
+                        double py_time = 0.0;
+                        if (fscanf(pipe, "%d %lf", &py_count, &py_time) == 2) {
+                            printf("\nPython regex:\n");
+                            printf("  Matches: %d\n", py_count);
+                            printf("  Time: %.3f ms\n", py_time);
+
+                            if (kmp.time_taken > 0.0 && py_time > 0.0) {
+                                if (kmp.time_taken < py_time) {
+                                    printf("\n[+] KMP is %.2fx faster than Python regex\n", py_time / kmp.time_taken);
+                                } else {
+                                    printf("\n[+] Python regex is %.2fx faster than KMP\n", kmp.time_taken / py_time);
+                                }
+                            }
+                        } else {
+                            printf("Python benchmark produced no output\n");
+                        }
+                        pclose(pipe);
+                    }
+                }
+
+                free_match_result(&kmp);
+                break;
+            }
+            
+            case 10: {
+                run_comprehensive_tests();
+                break;
+            }
+            
+            case 11: {
+                if (!sequence) {
+                    printf("Please load a sequence first!\n");
+                    break;
+                }
+                
+                print_algorithm_info(11);
+                printf("Enter pattern to search: ");
+                if (scanf("%255s", pattern) != 1) pattern[0] = '\0';
+                getchar();
+                
+                MatchResult result = rabin_karp_search(sequence->sequence, pattern);
+                print_match_result("Rabin-Karp Algorithm (Rolling Hash)", &result);
+                print_sequence_with_highlights(sequence->sequence, result.positions, result.count, strlen(pattern), 30);
+                free_match_result(&result);
+                break;
+            }
+            
+            case 12: {
+                if (!sequence) {
+                    printf("Please load a sequence first!\n");
+                    break;
+                }
+                
+                print_algorithm_info(12);
+                printf("Enter pattern to search: ");
+                if (scanf("%255s", pattern) != 1) pattern[0] = '\0';
+                getchar();
+                
+                MatchResult result = z_algorithm_search(sequence->sequence, pattern);
+                print_match_result("Z-Algorithm", &result);
+                print_sequence_with_highlights(sequence->sequence, result.positions, result.count, strlen(pattern), 30);
+                free_match_result(&result);
+                break;
+            }
+            
+            case 14: {
+                if (!sequence) {
+                    printf("Please load a sequence first!\n");
+                    break;
+                }
+
+                print_algorithm_info(14);
+                printf("Enter pattern to search: ");
+                if (scanf("%255s", pattern) != 1) pattern[0] = '\0';
+                getchar();
+
+                printf("Building FM-Index...\n");
+                clock_t start = clock();
+                FMIndex *index = create_fm_index(sequence->sequence);
+                clock_t end = clock();
+                printf("Construction time: %.3f ms\n",
+                       ((double)(end - start)) / CLOCKS_PER_SEC * 1000.0);
+
+                if (!index) {
+                    printf("Failed to build FM-Index!\n");
+                    break;
+                }
+
+                MatchResult result = fm_index_search(index, pattern);
+                print_match_result("FM-Index (Backward Search)", &result);
+                print_sequence_with_highlights(sequence->sequence, result.positions, result.count, strlen(pattern), 30);
+
+                printf("Save index to file for instant reload? (y/n): ");
+                char answer[8];
+                if (scanf("%7s", answer) != 1) answer[0] = 'n';
+                getchar();
+                if (answer[0] == 'y' || answer[0] == 'Y') {
+                    char index_file[256];
+                    printf("Enter index filename: ");
+                    if (scanf("%255s", index_file) == 1) {
+                        getchar();
+                        if (save_fm_index(index, index_file) == 0) {
+                            printf("Index saved to %s (reload with option 16)\n", index_file);
+                        }
+                    }
+                }
+
+                free_fm_index(index);
+                free_match_result(&result);
+                break;
+            }
+
+            case 16: {
+                char index_file[256];
+                printf("Enter index filename: ");
+                if (scanf("%255s", index_file) != 1) index_file[0] = '\0';
+                getchar();
+
+                clock_t load_start = clock();
+                FMIndex *index = load_fm_index(index_file);
+                clock_t load_end = clock();
+
+                if (!index) {
+                    printf("Failed to load index!\n");
+                    break;
+                }
+                printf("Index loaded (mmap) in %.3f ms\n",
+                       ((double)(load_end - load_start)) / CLOCKS_PER_SEC * 1000.0);
+
+                printf("Enter pattern to search: ");
+                if (scanf("%255s", pattern) != 1) pattern[0] = '\0';
+                getchar();
+
+                MatchResult result = fm_index_search(index, pattern);
+                print_match_result("FM-Index (Loaded from Disk)", &result);
+
+                free_fm_index(index);
+                free_match_result(&result);
+                break;
+            }
+
+            case 13: {
+                if (!sequence) {
+                    printf("Please load a sequence first!\n");
+                    break;
+                }
+                
+                print_algorithm_info(13);
+                printf("\n=== Aho-Corasick Multiple Pattern Matching ===\n");
+                printf("Enter number of patterns: ");
+                int num_patterns;
+                if (scanf("%d", &num_patterns) != 1) num_patterns = 0;
+                getchar();
+
+                if (num_patterns <= 0) {
+                    printf("Invalid number of patterns!\n");
+                    break;
+                }
+                
+                char **patterns = (char **)malloc(num_patterns * sizeof(char *));
+                for (int i = 0; i < num_patterns; i++) {
+                    patterns[i] = (char *)malloc(256 * sizeof(char));
+                    printf("Enter pattern %d: ", i + 1);
+                    if (scanf("%255s", patterns[i]) != 1) patterns[i][0] = '\0';
+                    getchar();
+                }
+                
+                MultiPatternResult result = aho_corasick_search(sequence->sequence, 
+                                                                (const char **)patterns, 
+                                                                num_patterns);
+                print_multi_pattern_result("Aho-Corasick Algorithm", &result, 
+                                          (const char **)patterns);
+                
+                free_multi_pattern_result(&result);
+                for (int i = 0; i < num_patterns; i++) {
+                    free(patterns[i]);
+                }
+                free(patterns);
+                break;
+            }
+            
+            case 17: {
+                if (!sequence) {
+                    printf("Please load a sequence first!\n");
+                    break;
+                }
+
+                printf("Enter pattern to search: ");
+                if (scanf("%255s", pattern) != 1) pattern[0] = '\0';
+                getchar();
+
+                printf("Algorithms: 0=Naive 1=KMP 2=Boyer-Moore 3=Rabin-Karp 4=Z 5=Shift-Or\n");
+                printf("Enter algorithm: ");
+                int algo_choice;
+                if (scanf("%d", &algo_choice) != 1) algo_choice = 1;
+                getchar();
+                if (algo_choice < 0 || algo_choice > 5) algo_choice = 1;
+
+                printf("Enter thread count (0 = all CPUs): ");
+                int nthreads;
+                if (scanf("%d", &nthreads) != 1) nthreads = 0;
+                getchar();
+
+                MatchResult result = parallel_search((SearchAlgorithm)algo_choice,
+                                                     sequence->sequence, sequence->length,
+                                                     pattern, nthreads);
+                print_match_result("Parallel Chunked Search", &result);
+                free_match_result(&result);
+                break;
+            }
+
+            case 18: {
+                if (!sequence) {
+                    printf("Please load a sequence first!\n");
+                    break;
+                }
+
+                printf("Enter pattern to search: ");
+                if (scanf("%255s", pattern) != 1) pattern[0] = '\0';
+                getchar();
+
+                PackedDNA *packed = pack_dna_sequence(sequence->sequence, sequence->length);
+                if (!packed) {
+                    printf("Packing failed - sequence must be pure ACGT (no N)\n");
+                    break;
+                }
+                printf("Packed %zu bases into %zu words (%zu bytes vs %zu bytes)\n",
+                       packed->length, packed->num_words,
+                       packed->num_words * sizeof(unsigned long long), packed->length);
+
+                MatchResult naive_result = packed_naive_search(packed, pattern);
+                print_match_result("Packed Naive (word-at-a-time)", &naive_result);
+
+                MatchResult kmp_result = packed_kmp_search(packed, pattern);
+                print_match_result("Packed KMP", &kmp_result);
+
+                free_match_result(&naive_result);
+                free_match_result(&kmp_result);
+                free_packed_dna(packed);
+                break;
+            }
+
+            case 19: {
+                char filename[256];
+                printf("Enter FASTA filename: ");
+                if (scanf("%255s", filename) != 1) filename[0] = '\0';
+                getchar();
+
+                printf("Enter pattern to search: ");
+                if (scanf("%255s", pattern) != 1) pattern[0] = '\0';
+                getchar();
+
+                CompiledPattern *handle = compile_pattern(pattern, SEARCH_ALGO_KMP);
+                if (!handle) {
+                    printf("Failed to compile pattern!\n");
+                    break;
+                }
+
+                clock_t start = clock();
+                long long matches = stream_search_file(handle, filename, 0, NULL, NULL);
+                clock_t end = clock();
+                free_compiled_pattern(handle);
+
+                if (matches < 0) {
+                    printf("Streaming search failed!\n");
+                    break;
+                }
+                printf("\n  [ + ] Found %lld matches (streamed, 4 MB windows)\n", matches);
+                printf("  [TIME] Time taken: %.3f ms\n",
+                       ((double)(end - start)) / CLOCKS_PER_SEC * 1000.0);
+                break;
+            }
+
+            case 24: {
+                char filename[256];
+                printf("Enter FASTA filename: ");
+                if (scanf("%255s", filename) != 1) filename[0] = '\0';
+                getchar();
+
+                printf("Enter pattern to search: ");
+                if (scanf("%255s", pattern) != 1) pattern[0] = '\0';
+                getchar();
+
+                CompiledPattern *handle = compile_pattern(pattern, SEARCH_ALGO_KMP);
+                if (!handle) {
+                    printf("Failed to compile pattern!\n");
+                    break;
+                }
+
+                // Wall clock: CPU time would sum both pipeline threads
+                struct timespec wall_start, wall_end;
+                clock_gettime(CLOCK_MONOTONIC, &wall_start);
+                long long matches = stream_search_file_pipelined(handle, filename, 0, NULL, NULL);
+                clock_gettime(CLOCK_MONOTONIC, &wall_end);
+                free_compiled_pattern(handle);
+
+                if (matches < 0) {
+                    printf("Pipelined streaming search failed!\n");
+                    break;
+                }
+                printf("\n  [ + ] Found %lld matches (pipelined, 4 MB ring buffers)\n", matches);
+                printf("  [TIME] Wall time: %.3f ms\n",
+                       (wall_end.tv_sec - wall_start.tv_sec) * 1000.0 +
+                       (wall_end.tv_nsec - wall_start.tv_nsec) / 1e6);
+                break;
+            }
+
+            case 22: {
+                if (!sequence) {
+                    printf("Please load a sequence first!\n");
+                    break;
+                }
+
+                int kval;
+                printf("Enter k-mer size (0 = default 12): ");
+                if (scanf("%d", &kval) != 1) kval = 0;
+                getchar();
+
+                printf("Building k-mer index...\n");
+                clock_t build_start = clock();
+                KmerIndex *kidx = create_kmer_index(sequence->sequence, kval);
+                clock_t build_end = clock();
+                if (!kidx) {
+                    printf("Failed to build k-mer index!\n");
+                    break;
+                }
+                printf("Index built in %.3f ms\n",
+                       ((double)(build_end - build_start)) / CLOCKS_PER_SEC * 1000.0);
+
+                printf("Enter pattern to search: ");
+                if (scanf("%255s", pattern) != 1) pattern[0] = '\0';
+                getchar();
+
+                MatchResult result = seed_and_extend_search(kidx, pattern);
+                print_match_result("k-mer Seed-and-Extend", &result);
+                free_match_result(&result);
+                free_kmer_index(kidx);
+                break;
+            }
+
+            case 25: {
+                if (!sequence) {
+                    printf("Please load a sequence first!\n");
+                    break;
+                }
+
+                printf("Enter pattern to search: ");
+                if (scanf("%255s", pattern) != 1) pattern[0] = '\0';
+                getchar();
+
+                if (!auto_profile_available()) {
+                    printf("No calibration profile found - using length heuristics.\n");
+                    printf("(Run ./bin/benchmark --calibrate once to measure this machine.)\n");
+                }
+
+                SearchAlgorithm chosen = auto_select_algorithm(
+                    sequence->sequence, sequence->length, pattern);
+                printf("Auto-selected algorithm: %s\n", search_algorithm_name(chosen));
+
+                MatchResult result = auto_search(sequence->sequence, sequence->length,
+                                                 pattern);
+                print_match_result("Auto-Select Search", &result);
+                free_match_result(&result);
+                break;
+            }
+
+            case 26: {
+                if (!sequence) {
+                    printf("Please load a sequence first!\n");
+                    break;
+                }
+
+                printf("\n=== Suffix Tree Probe Panel ===\n");
+                printf("Enter number of patterns: ");
+                int num_patterns;
+                if (scanf("%d", &num_patterns) != 1) num_patterns = 0;
+                getchar();
+
+                if (num_patterns <= 0) {
+                    printf("Invalid number of patterns!\n");
+                    break;
+                }
+
+                char **patterns = (char **)malloc(num_patterns * sizeof(char *));
+                for (int i = 0; i < num_patterns; i++) {
+                    patterns[i] = (char *)malloc(256 * sizeof(char));
+                    printf("Enter pattern %d: ", i + 1);
+                    if (scanf("%255s", patterns[i]) != 1) patterns[i][0] = '\0';
+                    getchar();
+                }
+
+                printf("Building suffix tree...\n");
+                clock_t build_start = clock();
+                SuffixTree *tree = create_suffix_tree(sequence->sequence);
+                clock_t build_end = clock();
+                if (!tree) {
+                    printf("Failed to build suffix tree!\n");
+                    for (int i = 0; i < num_patterns; i++) free(patterns[i]);
+                    free(patterns);
+                    break;
+                }
+                printf("Tree built in %.3f ms\n",
+                       ((double)(build_end - build_start)) / CLOCKS_PER_SEC * 1000.0);
+
+                struct timespec batch_start, batch_end;
+                clock_gettime(CLOCK_MONOTONIC, &batch_start);
+                MatchResult *results = suffix_tree_search_many(tree,
+                                                               (const char **)patterns,
+                                                               num_patterns);
+                clock_gettime(CLOCK_MONOTONIC, &batch_end);
+
+                if (results) {
+                    double batch_ms =
+                        (batch_end.tv_sec - batch_start.tv_sec) * 1000.0 +
+                        (batch_end.tv_nsec - batch_start.tv_nsec) / 1e6;
+                    printf("\nBatch of %d probes answered in %.3f ms\n",
+                           num_patterns, batch_ms);
+                    for (int i = 0; i < num_patterns; i++) {
+                        printf("  %-30s %d match%s", patterns[i],
+                               results[i].count, results[i].count == 1 ? "" : "es");
+                        if (results[i].count > 0) {
+                            printf(" (first at %d)", results[i].positions[0]);
+                        }
+                        printf("\n");
+                        free_match_result(&results[i]);
+                    }
+                    free(results);
+                } else {
+                    printf("Probe panel search failed!\n");
+                }
+
+                free_suffix_tree(tree);
+                for (int i = 0; i < num_patterns; i++) free(patterns[i]);
+                free(patterns);
+                break;
+            }
+
+            case 27: {
+                if (!sequence) {
+                    printf("Please load a sequence first!\n");
+                    break;
+                }
+
+                printf("Enter pattern to search: ");
+                if (scanf("%255s", pattern) != 1) pattern[0] = '\0';
+                getchar();
+
+                size_t chunk_size;
+                printf("Enter append chunk size in bases (e.g. 4096): ");
+                if (scanf("%zu", &chunk_size) != 1 || chunk_size == 0) chunk_size = 4096;
+                getchar();
+
+                IncrementalZ *iz = create_incremental_z(pattern);
+                if (!iz) {
+                    printf("Failed to create incremental matcher!\n");
+                    break;
+                }
+
+                // Simulate a day of appends: feed the loaded sequence in
+                // chunks, searching only the new data each time
+                printf("\n=== Incremental Z Search (chunked appends) ===\n");
+                int appends = 0;
+                double total_ms = 0.0;
+                for (size_t off = 0; off < sequence->length; off += chunk_size) {
+                    size_t len = sequence->length - off;
+                    if (len > chunk_size) len = chunk_size;
+                    MatchResult part = incremental_z_append(iz, sequence->sequence + off,
+                                                            len);
+                    total_ms += part.time_taken;
+                    appends++;
+                    free_match_result(&part);
+                }
+
+                printf("Appended %zu bases in %d chunks of %zu\n",
+                       sequence->length, appends, chunk_size);
+                printf("Total matches: %lld (search time %.3f ms, old data never rescanned)\n",
+                       iz->total_matches, total_ms);
+
+                MatchResult reference = z_algorithm_search(sequence->sequence, pattern);
+                printf("One-shot Z search agrees: %s (%d matches in %.3f ms)\n",
+                       (reference.count == iz->total_matches) ? "YES" : "NO",
+                       reference.count, reference.time_taken);
+                free_match_result(&reference);
+                free_incremental_z(iz);
+                break;
+            }
+
+            case 23: {
+                if (!sequence) {
+                    printf("Please load a sequence first!\n");
+                    break;
+                }
+
+                printf("Enter pattern to search: ");
+                if (scanf("%255s", pattern) != 1) pattern[0] = '\0';
+                getchar();
+
+                int mode;
+                printf("Modes: 1=Count only  2=Keep every Nth match\n");
+                printf("Enter mode: ");
+                if (scanf("%d", &mode) != 1) mode = 1;
+                getchar();
+
+                int algo_choice;
+                printf("Algorithms: 0=Naive 1=KMP 2=Boyer-Moore 3=Rabin-Karp 4=Z 5=Shift-Or\n");
+                printf("Enter algorithm: ");
+                if (scanf("%d", &algo_choice) != 1) algo_choice = 1;
+                getchar();
+                if (algo_choice < 0 || algo_choice > 5) algo_choice = 1;
+
+                MatchResult result;
+                if (mode == 2) {
+                    int every_nth;
+                    printf("Keep every Nth match, N = ");
+                    if (scanf("%d", &every_nth) != 1) every_nth = 10;
+                    getchar();
+
+                    result = sampled_search((SearchAlgorithm)algo_choice,
+                                            sequence->sequence, sequence->length,
+                                            pattern, every_nth);
+                    printf("\nKept every %d-th match (%d stored):\n", every_nth, result.count);
+                    print_match_result("Sampled Search", &result);
+                } else {
+                    result = count_only_search((SearchAlgorithm)algo_choice,
+                                               sequence->sequence, sequence->length,
+                                               pattern);
+                    print_match_result("Count-Only Search", &result);
+                }
+                free_match_result(&result);
+                break;
+            }
+
+            case 21: {
+                char filename[256];
+                printf("Enter multi-record FASTA filename: ");
+                if (scanf("%255s", filename) != 1) filename[0] = '\0';
+                getchar();
+
+                FastaCollection *collection = load_fasta_file_multi(filename);
+                if (!collection) {
+                    printf("Failed to load multi-record FASTA!\n");
+                    break;
+                }
+                printf("Loaded %d records\n", collection->count);
+
+                printf("Enter pattern to search: ");
+                if (scanf("%255s", pattern) != 1) pattern[0] = '\0';
+                getchar();
+
+                int algo_choice, nthreads;
+                printf("Algorithms: 0=Naive 1=KMP 2=Boyer-Moore 3=Rabin-Karp 4=Z 5=Shift-Or\n");
+                printf("Enter algorithm: ");
+                if (scanf("%d", &algo_choice) != 1) algo_choice = 2;
+                getchar();
+                if (algo_choice < 0 || algo_choice > 5) algo_choice = 2;
+
+                printf("Enter thread count (0 = all CPUs): ");
+                if (scanf("%d", &nthreads) != 1) nthreads = 0;
+                getchar();
+
+                MultiRecordResult result = multi_record_search(
+                    (SearchAlgorithm)algo_choice, collection, pattern, nthreads);
+                print_multi_record_result("Multi-Record Search", &result, collection);
+                free_multi_record_result(&result);
+                free_fasta_collection(collection);
+                break;
+            }
+
+            case 20: {
+                if (!sequence) {
+                    printf("Please load a sequence first!\n");
+                    break;
+                }
+
+                print_algorithm_info(20);
+                printf("Enter pattern to search: ");
+                if (scanf("%255s", pattern) != 1) pattern[0] = '\0';
+                getchar();
+
+                int max_dist;
+                printf("Enter maximum edit distance: ");
+                if (scanf("%d", &max_dist) != 1) max_dist = 1;
+                getchar();
+
+                ApproximateMatchResult result = myers_search(
+                    sequence->sequence, pattern, max_dist);
+                print_approximate_match_result("Myers Bit-Parallel Search", &result);
+                free_approximate_match_result(&result);
+                break;
+            }
+
+            case 0: {
+                if (sequence) {
+                    free_dna_sequence(sequence);
+                }
+                printf("\nThank you for using DNA Pattern Matching Suite!\n");
+                return 0;
+            }
+            
+            default:
+                printf("Invalid choice! Please try again.\n");
+        }
+    }
+    
+    return 0;
 }
\ No newline at end of file
@@ -0,0 +1,102 @@
+/*
+ * Arena Allocator
+ *
+ * Bump-pointer allocation out of large malloc'd blocks, released all at
+ * once with arena_destroy(). Built for node-heavy structures (suffix
+ * tree) where one malloc per node dominates construction time and a
+ * recursive free-per-node walk dominates teardown: allocation becomes a
+ * pointer bump, teardown frees a handful of blocks in O(1) per block,
+ * and nodes allocated together sit together in memory, which helps
+ * traversal cache locality.
+ *
+ * Allocations are never freed individually and are not resizable.
+ */
+
+#include "pattern_matching.h"
+
+// Large enough to hold a few thousand suffix tree nodes per block
+#define ARENA_DEFAULT_BLOCK_SIZE (4 * 1024 * 1024)
+
+// Bump offsets are rounded up so every allocation is suitably aligned
+#define ARENA_ALIGNMENT 16
+
+typedef struct ArenaBlock {
+    struct ArenaBlock *next;
+    size_t used;
+    size_t capacity;
+    // Block data follows the header
+} ArenaBlock;
+
+struct Arena {
+    ArenaBlock *head;       // Current block; older (full) blocks chained behind
+    size_t block_size;
+    size_t total_allocated; // Bytes handed out, across all blocks
+};
+
+static ArenaBlock* arena_new_block(size_t capacity) {
+    // Blocks are multi-MB and scanned hard during traversal - route
+    // through the huge-page-aware allocator
+    ArenaBlock *block = (ArenaBlock*)large_alloc(sizeof(ArenaBlock) + capacity);
+    if (!block) return NULL;
+
+    block->next = NULL;
+    block->used = 0;
+    block->capacity = capacity;
+    return block;
+}
+
+// block_size 0 selects the default (4 MB)
+Arena* arena_create(size_t block_size) {
+    Arena *arena = (Arena*)malloc(sizeof(Arena));
+    if (!arena) return NULL;
+
+    arena->block_size = (block_size > 0) ? block_size : ARENA_DEFAULT_BLOCK_SIZE;
+    arena->total_allocated = 0;
+    arena->head = arena_new_block(arena->block_size);
+    if (!arena->head) {
+        free(arena);
+        return NULL;
+    }
+    return arena;
+}
+
+// Returns zeroed memory (like calloc); NULL on exhaustion of the heap.
+// Requests larger than the block size get a dedicated block.
+void* arena_alloc(Arena *arena, size_t size) {
+    if (!arena || size == 0) return NULL;
+
+    size = (size + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+
+    if (arena->head->used + size > arena->head->capacity) {
+        size_t capacity = (size > arena->block_size) ? size : arena->block_size;
+        ArenaBlock *block = arena_new_block(capacity);
+        if (!block) return NULL;
+        block->next = arena->head;
+        arena->head = block;
+    }
+
+    char *ptr = (char*)(arena->head + 1) + arena->head->used;
+    arena->head->used += size;
+    arena->total_allocated += size;
+
+    memset(ptr, 0, size);
+    return ptr;
+}
+
+// Bytes handed out so far - used for memory accounting in results
+size_t arena_total_allocated(const Arena *arena) {
+    return arena ? arena->total_allocated : 0;
+}
+
+// Releases every block; all pointers from this arena become invalid
+void arena_destroy(Arena *arena) {
+    if (!arena) return;
+
+    ArenaBlock *block = arena->head;
+    while (block) {
+        ArenaBlock *next = block->next;
+        large_free(block);
+        block = next;
+    }
+    free(arena);
+}
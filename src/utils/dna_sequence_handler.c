@@ -4,9 +4,81 @@
 
 #define _GNU_SOURCE
 #include "pattern_matching.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#if defined(__x86_64__)
+#include <emmintrin.h>
+#endif
 
 #define INITIAL_BUFFER_SIZE 1024
 
+// Translation table for sanitization: each raw byte maps to its
+// upcased base, or 0 for bytes to drop (newlines, digits, stray
+// symbols). One load replaces the old strchr("ACGTN", c) call and
+// branchy lowercase conversion per nucleotide.
+static const unsigned char base_sanitize[256] = {
+    ['A'] = 'A', ['a'] = 'A',
+    ['C'] = 'C', ['c'] = 'C',
+    ['G'] = 'G', ['g'] = 'G',
+    ['T'] = 'T', ['t'] = 'T',
+    ['N'] = 'N', ['n'] = 'N',
+};
+
+/**
+ * Sanitizes len raw FASTA bytes into dst: upcases, keeps only ACGTN,
+ * compacts everything else out. dst may alias src (in-place) since the
+ * output never outruns the input. On x86-64, 16-byte blocks that are
+ * already clean uppercase ACGTN - the overwhelming case in FASTA body
+ * lines - are detected with one SSE2 compare and copied verbatim, so
+ * the pass is memory-bandwidth-bound on well-formed input; blocks with
+ * newlines or soft-masked bases fall through to the table loop.
+ * Returns: number of bases written to dst
+ */
+size_t sanitize_bases(const char *src, size_t len, char *dst) {
+    size_t out = 0;
+    size_t i = 0;
+
+#if defined(__x86_64__)
+    const __m128i va = _mm_set1_epi8('A');
+    const __m128i vc = _mm_set1_epi8('C');
+    const __m128i vg = _mm_set1_epi8('G');
+    const __m128i vt = _mm_set1_epi8('T');
+    const __m128i vn = _mm_set1_epi8('N');
+
+    while (i + 16 <= len) {
+        __m128i block = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i valid = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(block, va), _mm_cmpeq_epi8(block, vc)),
+            _mm_or_si128(_mm_cmpeq_epi8(block, vg),
+                         _mm_or_si128(_mm_cmpeq_epi8(block, vt),
+                                      _mm_cmpeq_epi8(block, vn))));
+        if (_mm_movemask_epi8(valid) == 0xFFFF) {
+            _mm_storeu_si128((__m128i *)(dst + out), block);
+            out += 16;
+        } else {
+            // Mixed block: branchless table pass over its 16 bytes
+            for (int k = 0; k < 16; k++) {
+                unsigned char c = base_sanitize[(unsigned char)src[i + k]];
+                dst[out] = (char)c;
+                out += (c != 0);
+            }
+        }
+        i += 16;
+    }
+#endif
+
+    for (; i < len; i++) {
+        unsigned char c = base_sanitize[(unsigned char)src[i]];
+        dst[out] = (char)c;
+        out += (c != 0);
+    }
+
+    return out;
+}
+
 DNASequence* load_fasta_file(const char *filename) {
     FILE *file = fopen(filename, "r");
     if (!file) {
@@ -25,7 +97,7 @@ DNASequence* load_fasta_file(const char *filename) {
     ssize_t read;
     
     size_t seq_capacity = INITIAL_BUFFER_SIZE;
-    seq->sequence = (char *)malloc(seq_capacity);
+    seq->sequence = (char *)large_alloc(seq_capacity);
     if (!seq->sequence) {
         free(seq);
         fclose(file);
@@ -55,9 +127,9 @@ DNASequence* load_fasta_file(const char *filename) {
             // Ensure capacity
             while (seq->length + read + 1 >= seq_capacity) { // +1 for null terminator safety
                 seq_capacity *= 2;
-                char *temp = (char *)realloc(seq->sequence, seq_capacity);
+                char *temp = (char *)large_realloc(seq->sequence, seq_capacity);
                 if (!temp) {
-                    free(seq->sequence);
+                    large_free(seq->sequence);
                     if (seq->header) free(seq->header);
                     free(seq);
                     free(line);
@@ -67,17 +139,8 @@ DNASequence* load_fasta_file(const char *filename) {
                 seq->sequence = temp;
             }
             
-            // Copy sequence data and convert to uppercase
-            for (int i = 0; i < read; i++) {
-                char c = line[i];
-                if (c >= 'a' && c <= 'z') {
-                    c = c - 'a' + 'A';
-                }
-                // Filter out non-DNA characters if any (optional, but good for safety)
-                if (strchr("ACGTN", c)) {
-                     seq->sequence[seq->length++] = c;
-                }
-            }
+            // Copy sequence data: upcase and filter in one table pass
+            seq->length += sanitize_bases(line, read, seq->sequence + seq->length);
         }
     }
     
@@ -89,6 +152,92 @@ DNASequence* load_fasta_file(const char *filename) {
     return seq;
 }
 
+/*
+ * Memory-mapped FASTA loader.
+ *
+ * Maps the whole file read-only and makes a single pass over the mapping,
+ * copying sequence characters into a buffer pre-sized from fstat(). This
+ * avoids the realloc-doubling of the getline() path: no intermediate
+ * copies, and peak memory never exceeds file size + final sequence size.
+ * The file size is a strict upper bound on sequence length (headers and
+ * newlines only shrink it), so the buffer is allocated exactly once.
+ */
+DNASequence* load_fasta_file_mmap(const char *filename) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Error: Cannot open file %s\n", filename);
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || st.st_size == 0) {
+        close(fd);
+        return NULL;
+    }
+    size_t file_size = (size_t)st.st_size;
+
+    const char *data = (const char *)mmap(NULL, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+        fprintf(stderr, "Error: mmap failed for %s\n", filename);
+        close(fd);
+        return NULL;
+    }
+    // Tell the kernel we read front-to-back so it can prefetch aggressively
+    madvise((void *)data, file_size, MADV_SEQUENTIAL);
+
+    DNASequence *seq = (DNASequence *)calloc(1, sizeof(DNASequence));
+    if (!seq) {
+        munmap((void *)data, file_size);
+        close(fd);
+        return NULL;
+    }
+
+    // Pre-sized buffer: file size is an upper bound on sequence length
+    seq->sequence = (char *)large_alloc(file_size + 1);
+    if (!seq->sequence) {
+        free(seq);
+        munmap((void *)data, file_size);
+        close(fd);
+        return NULL;
+    }
+    // Fault the pages in from worker threads before the serial copy so
+    // first-touch NUMA placement spreads them across the nodes that
+    // will scan the sequence later
+    large_first_touch(seq->sequence, file_size + 1, 0);
+    seq->length = 0;
+
+    size_t i = 0;
+    int first_header = 1;
+
+    while (i < file_size) {
+        if (data[i] == '>') {
+            // Header line: capture the first one, skip the rest
+            size_t line_start = i + 1;
+            while (i < file_size && data[i] != '\n') i++;
+            if (first_header) {
+                seq->header = strndup(data + line_start, i - line_start);
+                first_header = 0;
+            }
+            if (i < file_size) i++; // Skip newline
+        } else {
+            // Sequence line: sanitize the whole line in one pass
+            size_t line_start = i;
+            const char *nl = memchr(data + i, '\n', file_size - i);
+            i = nl ? (size_t)(nl - data) : file_size;
+            seq->length += sanitize_bases(data + line_start, i - line_start,
+                                          seq->sequence + seq->length);
+            if (i < file_size) i++; // Skip newline
+        }
+    }
+
+    seq->sequence[seq->length] = '\0';
+
+    munmap((void *)data, file_size);
+    close(fd);
+
+    return seq;
+}
+
 void free_dna_sequence(DNASequence *seq) {
     if (!seq) return;
     
@@ -97,14 +246,149 @@ void free_dna_sequence(DNASequence *seq) {
         seq->header = NULL;
     }
     if (seq->sequence) {
-        free(seq->sequence);
+        large_free(seq->sequence);
         seq->sequence = NULL;
     }
     free(seq);
 }
 
+/*
+ * Streaming FASTA reader: delivers sanitized sequence data (uppercase,
+ * ACGTN only, headers and newlines stripped) in caller-sized buffers
+ * without ever materializing the whole sequence. The header-line state
+ * survives across reads, so buffer boundaries may fall anywhere.
+ */
+FastaStream* fasta_stream_open(const char *filename) {
+    FILE *file = fopen(filename, "r");
+    if (!file) {
+        fprintf(stderr, "Error: Cannot open file %s\n", filename);
+        return NULL;
+    }
+
+    FastaStream *stream = (FastaStream *)calloc(1, sizeof(FastaStream));
+    if (!stream) {
+        fclose(file);
+        return NULL;
+    }
+    stream->file = file;
+    stream->in_header = 0;
+    return stream;
+}
+
+// Fills buffer with up to capacity sanitized bases.
+// Returns: number of bases delivered, 0 at end of file, -1 on error
+long fasta_stream_read(FastaStream *stream, char *buffer, size_t capacity) {
+    if (!stream || !buffer || capacity == 0) return -1;
+
+    size_t out = 0;
+
+    // Loop so a chunk of pure header/newline bytes does not look like EOF
+    while (out == 0) {
+        size_t raw = fread(buffer, 1, capacity, stream->file);
+        if (raw == 0) {
+            return ferror(stream->file) ? -1 : 0;
+        }
+
+        // Sanitize in place: output never outruns input. Outside headers
+        // whole segments go through the vectorized table pass (newlines
+        // are dropped by the table), with '>' flipping the header state.
+        size_t i = 0;
+        while (i < raw) {
+            if (stream->in_header) {
+                const char *nl = memchr(buffer + i, '\n', raw - i);
+                if (!nl) break;  // Header continues into the next read
+                i = (size_t)(nl - buffer) + 1;
+                stream->in_header = 0;
+            } else {
+                const char *gt = memchr(buffer + i, '>', raw - i);
+                size_t seg_end = gt ? (size_t)(gt - buffer) : raw;
+                out += sanitize_bases(buffer + i, seg_end - i, buffer + out);
+                i = seg_end;
+                if (gt) {
+                    stream->in_header = 1;
+                    i++;
+                }
+            }
+        }
+    }
+
+    return (long)out;
+}
+
+void fasta_stream_close(FastaStream *stream) {
+    if (!stream) return;
+
+    if (stream->file) {
+        fclose(stream->file);
+    }
+    free(stream);
+}
+
+/*
+ * 2-bit packing: A=0, C=1, G=2, T=3, 32 bases per 64-bit word with base
+ * i at bits [2i, 2i+1] of word i/32. Quarter of the one-byte-per-base
+ * footprint. Sequences containing N (or anything else non-ACGT) cannot
+ * be packed losslessly and are rejected - N-masking is handled upstream.
+ */
+PackedDNA* pack_dna_sequence(const char *sequence, size_t length) {
+    if (!sequence) return NULL;
+
+    PackedDNA *packed = (PackedDNA *)calloc(1, sizeof(PackedDNA));
+    if (!packed) return NULL;
+
+    packed->length = length;
+    packed->num_words = (length + 31) / 32;
+    packed->words = (unsigned long long *)calloc(packed->num_words ? packed->num_words : 1,
+                                                 sizeof(unsigned long long));
+    if (!packed->words) {
+        free(packed);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < length; i++) {
+        unsigned long long code;
+        switch (sequence[i]) {
+            case 'A': code = 0; break;
+            case 'C': code = 1; break;
+            case 'G': code = 2; break;
+            case 'T': code = 3; break;
+            default:
+                fprintf(stderr, "Error: Cannot pack non-ACGT base '%c' at position %zu\n",
+                        sequence[i], i);
+                free_packed_dna(packed);
+                return NULL;
+        }
+        packed->words[i / 32] |= code << (2 * (i % 32));
+    }
+
+    return packed;
+}
+
+// Convenience loader: mmap load then pack, dropping the byte copy
+PackedDNA* load_fasta_file_packed(const char *filename) {
+    DNASequence *seq = load_fasta_file_mmap(filename);
+    if (!seq) seq = load_fasta_file(filename);
+    if (!seq) return NULL;
+
+    PackedDNA *packed = pack_dna_sequence(seq->sequence, seq->length);
+    free_dna_sequence(seq);
+    return packed;
+}
+
+void free_packed_dna(PackedDNA *packed) {
+    if (!packed) return;
+
+    if (packed->words) {
+        free(packed->words);
+        packed->words = NULL;
+    }
+    free(packed);
+}
+
+// Caller frees the returned buffer with large_free() - generated
+// corpora can be genome-scale, so they take the huge-page path too
 char* generate_random_dna(int length) {
-    char *sequence = (char *)malloc((length + 1) * sizeof(char));
+    char *sequence = (char *)large_alloc((length + 1) * sizeof(char));
     if (!sequence) {
         fprintf(stderr, "Memory allocation failed\n");
         return NULL;
@@ -118,4 +402,142 @@ char* generate_random_dna(int length) {
     
     sequence[length] = '\0';
     return sequence;
-}
\ No newline at end of file
+}
+// Watson-Crick complement per base; N (and anything unrecognized) maps to N
+static char complement_base(char c) {
+    switch (c) {
+        case 'A': return 'T';
+        case 'T': return 'A';
+        case 'C': return 'G';
+        case 'G': return 'C';
+        case 'a': return 't';
+        case 't': return 'a';
+        case 'c': return 'g';
+        case 'g': return 'c';
+        default:  return 'N';
+    }
+}
+
+// Reverse complement of a pattern - what the opposite strand reads.
+// Returns a malloc'd string the caller frees, or NULL on failure.
+char* reverse_complement(const char *pattern) {
+    if (!pattern) return NULL;
+
+    size_t m = strlen(pattern);
+    char *rev = (char *)malloc(m + 1);
+    if (!rev) {
+        fprintf(stderr, "Memory allocation failed\n");
+        return NULL;
+    }
+
+    for (size_t i = 0; i < m; i++) {
+        rev[i] = complement_base(pattern[m - 1 - i]);
+    }
+    rev[m] = '\0';
+    return rev;
+}
+
+/*
+ * Multi-record FASTA loader.
+ *
+ * load_fasta_file() keeps only the first header and concatenates every
+ * record into one sequence, which invents matches across record
+ * boundaries. This loader returns one DNASequence per '>' record, each
+ * with its own header, sanitized the same way (uppercase, ACGTN only).
+ */
+FastaCollection* load_fasta_file_multi(const char *filename) {
+    FILE *file = fopen(filename, "r");
+    if (!file) {
+        fprintf(stderr, "Error: Cannot open file %s\n", filename);
+        return NULL;
+    }
+
+    FastaCollection *collection = (FastaCollection *)calloc(1, sizeof(FastaCollection));
+    if (!collection) {
+        fclose(file);
+        return NULL;
+    }
+
+    int record_capacity = 16;
+    collection->records = (DNASequence **)malloc(record_capacity * sizeof(DNASequence *));
+    if (!collection->records) {
+        free(collection);
+        fclose(file);
+        return NULL;
+    }
+    collection->count = 0;
+
+    DNASequence *current = NULL;
+    size_t seq_capacity = 0;
+
+    char *line = NULL;
+    size_t len = 0;
+    ssize_t read;
+
+    while ((read = getline(&line, &len, file)) != -1) {
+        if (read > 0 && line[read - 1] == '\n') {
+            line[read - 1] = '\0';
+            read--;
+        }
+        if (read == 0) continue;
+
+        if (line[0] == '>') {
+            // Start a new record
+            if (collection->count >= record_capacity) {
+                record_capacity *= 2;
+                DNASequence **temp = (DNASequence **)realloc(collection->records,
+                                     record_capacity * sizeof(DNASequence *));
+                if (!temp) goto fail;
+                collection->records = temp;
+            }
+
+            current = (DNASequence *)calloc(1, sizeof(DNASequence));
+            if (!current) goto fail;
+            collection->records[collection->count++] = current;
+
+            current->header = strdup(line + 1);
+            seq_capacity = INITIAL_BUFFER_SIZE;
+            current->sequence = (char *)large_alloc(seq_capacity);
+            if (!current->sequence) goto fail;
+            current->length = 0;
+            current->sequence[0] = '\0';
+        } else if (current) {
+            // Sequence line (data before any header is ignored)
+            while (current->length + read + 1 >= seq_capacity) {
+                seq_capacity *= 2;
+                char *temp = (char *)large_realloc(current->sequence, seq_capacity);
+                if (!temp) goto fail;
+                current->sequence = temp;
+            }
+            current->length += sanitize_bases(line, read,
+                                              current->sequence + current->length);
+            current->sequence[current->length] = '\0';
+        }
+    }
+
+    free(line);
+    fclose(file);
+
+    if (collection->count == 0) {
+        fprintf(stderr, "Error: No FASTA records found in %s\n", filename);
+        free_fasta_collection(collection);
+        return NULL;
+    }
+    return collection;
+
+fail:
+    free(line);
+    fclose(file);
+    free_fasta_collection(collection);
+    return NULL;
+}
+
+void free_fasta_collection(FastaCollection *collection) {
+    if (!collection) return;
+
+    for (int i = 0; i < collection->count; i++) {
+        free_dna_sequence(collection->records[i]);
+    }
+    free(collection->records);
+    free(collection);
+}
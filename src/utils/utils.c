@@ -4,6 +4,19 @@
 
 #include "pattern_matching.h"
 
+// Zeroes a result so new instrumentation fields are never garbage;
+// hardware counters start at -1 (unavailable until a timer fills them)
+void init_match_result(MatchResult *result) {
+    result->positions = NULL;
+    result->count = 0;
+    result->time_taken = 0.0;
+    result->memory_used = 0;
+    result->wall_time_ns = 0;
+    result->hw_cycles = -1;
+    result->hw_cache_misses = -1;
+    result->hw_branch_misses = -1;
+}
+
 void free_match_result(MatchResult *result) {
     if (result && result->positions) {
         free(result->positions);
@@ -33,10 +46,21 @@ void print_match_result(const char *algo_name, const MatchResult *result) {
         printf("  [ + ] Found %d matches\n", result->count);
     }
     
-    printf("  [TIME] Time taken: %.3f ms\n", result->time_taken);
+    printf("  [TIME] CPU time: %.3f ms", result->time_taken);
+    if (result->wall_time_ns > 0) {
+        printf(" | Wall time: %.6f ms", result->wall_time_ns / 1000000.0);
+    }
+    printf("\n");
+    if (result->hw_cycles >= 0 || result->hw_cache_misses >= 0 || result->hw_branch_misses >= 0) {
+        printf("  [HW  ] Cycles: %lld | Cache misses: %lld | Branch misses: %lld\n",
+               result->hw_cycles, result->hw_cache_misses, result->hw_branch_misses);
+    }
     printf("  [MEM ] Memory used: %zu bytes\n", result->memory_used);
-    
-    if (result->count > 0 && result->count <= 100) {
+
+    if (result->count > 0 && !result->positions) {
+        // Count-only results carry no position array
+        printf("  [POS ] Positions not stored (count-only query)\n");
+    } else if (result->count > 0 && result->count <= 100) {
         printf("  [POS ] Match positions: ");
         for (int i = 0; i < result->count; i++) {
             printf("%d", result->positions[i]);
@@ -187,3 +211,87 @@ void print_sequence_with_highlights(const char *sequence, const int *positions,
     }
     */
 }
+
+void free_strand_match_result(StrandMatchResult *result) {
+    if (result) {
+        free(result->positions);
+        free(result->strands);
+        result->positions = NULL;
+        result->strands = NULL;
+        result->count = 0;
+    }
+}
+
+void print_strand_match_result(const char *algo_name, const StrandMatchResult *result) {
+    printf("\n+---------------------------------------------------------+\n");
+    printf("|  [ALGO] %s%-*s|\n", algo_name, (int)(50 - strlen(algo_name)), "");
+    printf("+---------------------------------------------------------+\n");
+
+    if (result->count == 0) {
+        printf("  [ - ] No matches found on either strand\n");
+    } else if (result->count == 1) {
+        printf("  [ + ] Found %d match\n", result->count);
+    } else {
+        printf("  [ + ] Found %d matches\n", result->count);
+    }
+
+    printf("  [TIME] Time taken: %.3f ms\n", result->time_taken);
+    printf("  [MEM ] Memory used: %zu bytes\n", result->memory_used);
+
+    if (result->count > 0) {
+        int display_count = result->count > 100 ? 100 : result->count;
+        printf("  [POS ] Match positions (strand): ");
+        for (int i = 0; i < display_count; i++) {
+            printf("%d(%c)", result->positions[i], result->strands[i]);
+            if (i < display_count - 1) printf(", ");
+        }
+        if (result->count > 100) {
+            printf(" ... (+%d more)", result->count - 100);
+        }
+        printf("\n");
+    }
+    printf("\n");
+}
+
+void free_multi_record_result(MultiRecordResult *result) {
+    if (result && result->matches) {
+        free(result->matches);
+        result->matches = NULL;
+        result->count = 0;
+    }
+}
+
+void print_multi_record_result(const char *algo_name, const MultiRecordResult *result,
+                               const FastaCollection *collection) {
+    printf("\n+---------------------------------------------------------+\n");
+    printf("|  [ALGO] %s%-*s|\n", algo_name, (int)(50 - strlen(algo_name)), "");
+    printf("+---------------------------------------------------------+\n");
+
+    if (result->count == 0) {
+        printf("  [ - ] No matches found in any record\n");
+    } else if (result->count == 1) {
+        printf("  [ + ] Found %d match\n", result->count);
+    } else {
+        printf("  [ + ] Found %d matches\n", result->count);
+    }
+
+    printf("  [TIME] Time taken: %.3f ms\n", result->time_taken);
+    printf("  [MEM ] Memory used: %zu bytes\n", result->memory_used);
+
+    if (result->count > 0) {
+        int display_count = result->count > 100 ? 100 : result->count;
+        printf("\n  [INFO] Match details:\n");
+        for (int i = 0; i < display_count; i++) {
+            int r = result->matches[i].record_id;
+            const char *header = (collection && r < collection->count &&
+                                  collection->records[r]->header)
+                                 ? collection->records[r]->header : "(no header)";
+            printf("     Record[%d] '%.40s' -> Position %d\n",
+                   r, header, result->matches[i].position);
+        }
+        if (result->count > 100) {
+            printf("     ... and %d more matches\n", result->count - 100);
+        }
+    }
+    printf("\n");
+}